@@ -8,87 +8,170 @@
 #include "day06.hpp"
 
 #include <aoc.hpp>
+#include <aoc_parse.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
 #include <fmt/format.h>
 
-#include <regex>
-#include <string>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
+#include <vector>
 
 namespace aoc::year2015 {
 
 namespace lights {
 
-light_action string_to_action(std::string_view s)
-{
-    if (s == "turn on") {
-        return light_action::on;
-    }
-    else if (s == "turn off") {
-        return light_action::off;
-    }
-    else if (s == "toggle") {
-        return light_action::toggle;
-    }
-    throw input_error(fmt::format("unknown light_action [{}]", s));
-}
+namespace {
+
+constexpr auto corner{parse::integer<int> + "," + parse::integer<int>};
+constexpr auto instruction_grammar{
+    (parse::lit("turn on ", light_action::on) |
+     parse::lit("turn off ", light_action::off) |
+     parse::lit("toggle ", light_action::toggle)) +
+    corner + " through " + corner};
+
+}  // namespace
 
-// TODO: CTRE?
 instruction string_to_instruction(std::string_view s)
 {
-    const std::regex r{"(.+) (\\d+),(\\d+) through (\\d+),(\\d+)"};
-    std::smatch m;
-
-    const std::string str{s};
-    if (!std::regex_match(str, m, r)) {
-        throw input_error(fmt::format("invalid rectangle [{}]", s));
-    }
-    auto action_str{m[1].str()};
-    auto x1{std::stoi(m[2].str())};
-    auto y1{std::stoi(m[3].str())};
-    auto x2{std::stoi(m[4].str())};
-    auto y2{std::stoi(m[5].str())};
-    return {string_to_action(action_str),
-            {{x1, y1}, {x2 - x1 + 1, y2 - y1 + 1}}};
+    const auto [action, x1, y1, x2, y2]{
+        parse::parse_line(instruction_grammar, s)};
+    return {action, {{x1, y1}, {x2 - x1 + 1, y2 - y1 + 1}}};
 }
 
 }  // namespace lights
 
 using namespace lights;
 
-void apply_instruction(auto& lights, const instruction& i)
+namespace {
+
+// Every instruction, one column per field of the grammar: the action, then the
+// corners' coordinates x1, y1, x2, y2, inclusive.
+using instruction_table =
+    parse::record_table<decltype(instruction_grammar)::value_type>;
+
+// Rectangle of lights covered by instruction `i`.
+rect<int> region_of(const instruction_table& instructions, std::size_t i)
 {
-    auto data = lights.subgrid(i.region).data();
-    for (auto& l : data) {
-        do_action(l, i.action);
-    }
+    const int x1{instructions.column<1>()[i]};
+    const int y1{instructions.column<2>()[i]};
+    return {{x1, y1},
+            {instructions.column<3>()[i] - x1 + 1,
+             instructions.column<4>()[i] - y1 + 1}};
 }
 
-void apply_instructions(auto& lights, const auto& instructions)
+}  // namespace
+
+// The instructions' rectangle edges split the 1000x1000 grid into a much
+// smaller grid of blocks, where every light in a block is covered by exactly the
+// same instructions and so always has the same state.  Simulating one light per
+// block, weighted by the block's area, makes the work depend on the number of
+// instructions rather than the area they cover.
+//
+// (The instructions can't be applied with a difference grid: "turn on", "turn
+// off" and dimming to no lower than zero all depend on the current state of
+// each light.)
+class compressed_grid {
+   public:
+    explicit compressed_grid(const instruction_table& instructions)
+    {
+        const auto edges{[&](auto first, auto last, std::vector<int>& out) {
+            out.reserve(2 * instructions.size() + 2);
+            out.push_back(0);
+            out.push_back(1000);
+            out.insert(out.end(), first.begin(), first.end());
+            for (const int edge : last) {
+                out.push_back(edge + 1);
+            }
+        }};
+        edges(instructions.column<1>(), instructions.column<3>(), xs_);
+        edges(instructions.column<2>(), instructions.column<4>(), ys_);
+        r::sort(xs_);
+        xs_.erase(r::unique(xs_), xs_.end());
+        r::sort(ys_);
+        ys_.erase(r::unique(ys_), ys_.end());
+    }
+
+    int width() const noexcept { return static_cast<int>(xs_.size()) - 1; }
+    int height() const noexcept { return static_cast<int>(ys_.size()) - 1; }
+
+    // Rectangle of blocks exactly covering the given rectangle of lights.
+    rect<int> compress(const rect<int>& region) const noexcept
+    {
+        const auto x0{index_of(xs_, region.base.x)};
+        const auto y0{index_of(ys_, region.base.y)};
+        const auto x1{index_of(xs_, region.base.x + region.dimensions.x)};
+        const auto y1{index_of(ys_, region.base.y + region.dimensions.y)};
+        return {{x0, y0}, {x1 - x0, y1 - y0}};
+    }
+
+    // Number of lights in the block at `p`.
+    std::int64_t area(vec2<int> p) const noexcept
+    {
+        const auto x{static_cast<std::size_t>(p.x)};
+        const auto y{static_cast<std::size_t>(p.y)};
+        return std::int64_t{xs_[x + 1] - xs_[x]} * (ys_[y + 1] - ys_[y]);
+    }
+
+   private:
+    std::vector<int> xs_;
+    std::vector<int> ys_;
+
+    static int index_of(const std::vector<int>& edges, int edge) noexcept
+    {
+        return static_cast<int>(r::lower_bound(edges, edge) - edges.begin());
+    }
+};
+
+// Apply every instruction to one light per block, then total up `brightness`
+// of each light multiplied by the number of lights it stands for.
+template <typename Light>
+std::int64_t total_brightness(const compressed_grid& blocks,
+                              const instruction_table& instructions,
+                              auto brightness)
 {
-    for (const auto& i : instructions) {
-        apply_instruction(lights, i);
+    const auto width{static_cast<std::size_t>(blocks.width())};
+    std::vector<Light> lights(width * static_cast<std::size_t>(blocks.height()));
+    const auto light_at{[&](vec2<int> p) -> Light& {
+        return lights[static_cast<std::size_t>(p.y) * width +
+                      static_cast<std::size_t>(p.x)];
+    }};
+
+    const auto actions{instructions.column<0>()};
+    for (std::size_t i{0}; i < instructions.size(); i++) {
+        const auto region{blocks.compress(region_of(instructions, i))};
+        for (int y{region.base.y}; y < region.base.y + region.dimensions.y;
+             y++) {
+            for (int x{region.base.x}; x < region.base.x + region.dimensions.x;
+                 x++) {
+                do_action(light_at({x, y}), actions[i]);
+            }
+        }
+    }
+
+    std::int64_t total{0};
+    for (int y{0}; y < blocks.height(); y++) {
+        for (int x{0}; x < blocks.width(); x++) {
+            total += brightness(light_at({x, y})) * blocks.area({x, y});
+        }
     }
+    return total;
 }
 
 aoc::solution_result day06(std::string_view input)
 {
-    const auto instructions{sv_lines(input) |
-                            rv::transform(string_to_instruction) |
-                            r::to<std::vector>};
-
-    binary_light_grid lights;
-    apply_instructions(lights, instructions);
-
-    dimmable_light_grid lights_b;
-    apply_instructions(lights_b, instructions);
+    const auto instructions{parse::parse_table(instruction_grammar, input)};
+    const compressed_grid blocks{instructions};
 
-    auto to_int{[](const dimmable_light l) -> int { return l; }};
+    const auto is_on{[](const binary_light l) -> std::int64_t {
+        return l ? 1 : 0;
+    }};
+    const auto to_int{[](const dimmable_light l) -> std::int64_t { return l; }};
 
-    return {r::count(lights.data(), true),
-            r::accumulate(lights_b.data() | rv::transform(to_int), 0)};
+    return {total_brightness<binary_light>(blocks, instructions, is_on),
+            total_brightness<dimmable_light>(blocks, instructions, to_int)};
 }
 
 }  // namespace aoc::year2015
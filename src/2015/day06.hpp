@@ -17,7 +17,6 @@
 #include <fmt/format.h>
 
 #include <bitset>
-#include <regex>
 #include <string_view>
 
 namespace aoc::year2015::lights {
@@ -15,7 +15,7 @@ aoc::solution_result day07(std::string_view input)
     auto circuit{gates::build_circuit(input)};
     circuit.evaluate();
     const auto answer_a{circuit.get_signal("a")};
-    circuit.reset();
+    // Only the gates downstream of b are evaluated again.
     circuit.set_signal("b", answer_a);
     circuit.evaluate();
     const auto answer_b{circuit.get_signal("a")};
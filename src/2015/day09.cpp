@@ -7,14 +7,15 @@
 
 #include <aoc.hpp>
 #include <aoc_range.hpp>
+#include <aoc_tsp.hpp>
 
 #include <fmt/format.h>
 
 #include <ctre.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
-#include <type_traits>
 
 namespace aoc::year2015 {
 
@@ -25,8 +26,6 @@ using distance_t = std::uint64_t;
 struct location_pair {
     std::string_view source;
     std::string_view destination;
-    friend auto operator<=>(const location_pair& lhs,
-                            const location_pair& rhs) = default;
 };
 
 struct location_entry {
@@ -50,16 +49,6 @@ aoc::solution_result day09(std::string_view input)
     const auto lines{sv_lines(input)};
     const auto entries{lines | rv::transform(parse_entry) | r::to<std::vector>};
 
-    const auto pair_distances{entries |
-                              rv::transform([](const location_entry& entry) {
-                                  auto pair{entry.pair};
-                                  if (pair.source < pair.destination) {
-                                      std::swap(pair.source, pair.destination);
-                                  }
-                                  return std::make_pair(pair, entry.distance);
-                              }) |
-                              r::to<std::map<location_pair, distance_t>>};
-
     const auto sources{entries | rv::transform([](const auto& entry) {
                            return entry.pair.source;
                        })};
@@ -71,21 +60,26 @@ aoc::solution_result day09(std::string_view input)
     r::sort(locations);
     locations.erase(r::unique(locations), locations.end());
 
-    const auto permutation_to_cost{[&pair_distances](const auto& permutation) {
-        const auto sliding{permutation | rv::sliding(2)};
-        const auto costs{sliding |
-                         rv::transform([&pair_distances](const auto&& pair) {
-                             location_pair p2{pair[0], pair[1]};
-                             if (p2.source < p2.destination) {
-                                 std::swap(p2.source, p2.destination);
-                             }
-                             return pair_distances.at(p2);
-                         })};
-        return r::accumulate(costs, 0);
+    const auto n{locations.size()};
+    if (entries.size() != n * (n - 1) / 2) {
+        throw input_error{"expected a distance between every two locations"};
+    }
+    const auto index{[&locations](std::string_view location) {
+        const auto found{r::lower_bound(locations, location)};
+        return static_cast<std::size_t>(r::distance(locations.begin(), found));
     }};
+    tsp::distance_matrix<distance_t> distances{n};
+    for (const auto& [pair, distance] : entries) {
+        const auto a{index(pair.source)};
+        const auto b{index(pair.destination)};
+        distances(a, b) = distance;
+        distances(b, a) = distance;
+    }
 
-    const auto [shortest, longest]{r::minmax(
-        permutation_generator(locations) | rv::transform(permutation_to_cost))};
+    const auto shortest{
+        tsp::solve(distances, tsp::route::path, tsp::objective::minimize)};
+    const auto longest{
+        tsp::solve(distances, tsp::route::path, tsp::objective::maximize)};
 
     return {shortest, longest};
 }
@@ -5,54 +5,18 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
-#include <aoc.hpp>
+#include "look_and_say.hpp"
 
-#include <fmt/format.h>
+#include <aoc.hpp>
 
-#include <string>
 #include <string_view>
 
 namespace aoc::year2015 {
 
-namespace {
-
-[[nodiscard]] std::string rle_encode(const std::string& input)
-{
-    std::string out;
-    const auto end{input.end()};
-    auto iter{input.begin()};
-    while (iter != end) {
-        const char c{*iter};
-        int length{0};
-        while (iter != end && *iter == c) {
-            iter++;
-            length++;
-        }
-        out.push_back(static_cast<char>(length) + '0');
-        out.push_back(c);
-    }
-
-    return out;
-}
-
-}  // namespace
-
 aoc::solution_result day10(std::string_view input)
 {
-    input = trim(input);
-
-    std::string input_str{input};
-    for (int i{0}; i < 40; i++) {
-        input_str = rle_encode(input_str);
-    }
-    const auto result_a{input_str.length()};
-
-    for (int i{0}; i < 10; i++) {
-        input_str = rle_encode(input_str);
-    }
-    const auto result_b{input_str.length()};
-
-    return {result_a, result_b};
+    const look_and_say::sequence sequence{trim(input)};
+    return {sequence.length_after(40), sequence.length_after(50)};
 }
 
 }  // namespace aoc::year2015
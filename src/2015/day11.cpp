@@ -8,94 +8,183 @@
 #include <aoc.hpp>
 #include <aoc_range.hpp>
 
+#include <fmt/format.h>
+
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
 
 namespace aoc::year2015 {
 
 namespace {
 
 using password_t = std::array<char, 8>;
-using password_number_t = std::uint64_t;
+constexpr int alphabet_size{26};
 
-password_number_t password_to_number(auto&& password)
+bool is_disallowed(int letter)
 {
-    return r::accumulate(
-        password, password_number_t{}, [](password_number_t out, char c) {
-            auto char_num{static_cast<password_number_t>(c - 'a')};
-            out *= 26;
-            out += char_num;
-            return out;
-        });
+    return letter == 'i' - 'a' || letter == 'o' - 'a' || letter == 'l' - 'a';
 }
 
-password_t number_to_password(password_number_t number)
-{
-    password_t out{0};
-    for (char& c : out | rv::reverse) {
-        c = static_cast<char>(number % 26) + 'a';
-        number /= 26;
+// What the rules need to know about the letters of a password so far.  Pairs
+// are counted greedily from the left, so "aaa" holds one pair and "aaaa" two.
+struct rule_state {
+    int last{-1};
+    // Length of the increasing run ending at `last`, while still short of a
+    // straight.
+    int run{0};
+    bool straight{false};
+    int pairs{0};
+    // Whether `last` can start a pair, not being the end of one.
+    bool pair_open{false};
+
+    rule_state then(int letter) const
+    {
+        rule_state next{*this};
+        next.last = letter;
+        if (!straight) {
+            next.run = (letter == last + 1) ? run + 1 : 1;
+            if (next.run == 3) {
+                next.straight = true;
+                next.run = 0;
+            }
+        }
+        if (pairs < 2) {
+            if (pair_open && letter == last) {
+                next.pairs++;
+                next.pair_open = false;
+            }
+            else {
+                next.pair_open = true;
+            }
+        }
+        if (next.pairs == 2) {
+            next.pair_open = false;
+        }
+        return next;
+    }
+
+    bool valid() const { return straight && pairs == 2; }
+};
+
+// Finds the smallest letters which complete a password from a `rule_state`.
+// Whether a completion exists depends only on the state and the number of
+// letters left, of which there are few enough combinations to remember them
+// all, so each letter of the completion is chosen with a lookup per
+// candidate.
+class completion_search {
+   public:
+    bool possible(const rule_state& state, std::size_t remaining)
+    {
+        if (remaining == 0) {
+            return state.valid();
+        }
+        auto& known{known_[index(state, remaining)]};
+        if (known == unknown) {
+            known = no;
+            for (int letter{0}; letter < alphabet_size; letter++) {
+                if (!is_disallowed(letter) &&
+                    possible(state.then(letter), remaining - 1)) {
+                    known = yes;
+                    break;
+                }
+            }
+        }
+        return known == yes;
+    }
+
+    // Fill `out` with the smallest letters completing a password from
+    // `state`, which must be possible.
+    void complete(rule_state state, std::span<char> out)
+    {
+        for (std::size_t i{0}; i < out.size(); i++) {
+            int letter{0};
+            while (is_disallowed(letter) ||
+                   !possible(state.then(letter), out.size() - i - 1)) {
+                letter++;
+            }
+            out[i] = static_cast<char>('a' + letter);
+            state = state.then(letter);
+        }
     }
-    return out;
-}
+
+   private:
+    enum answer : std::uint8_t { unknown, no, yes };
+    static constexpr std::size_t max_remaining{std::tuple_size_v<password_t>};
+
+    static std::size_t index(const rule_state& state, std::size_t remaining)
+    {
+        auto key{static_cast<std::size_t>(state.last)};
+        key = key * 3 + static_cast<std::size_t>(state.run);
+        key = key * 2 + static_cast<std::size_t>(state.straight);
+        key = key * 3 + static_cast<std::size_t>(state.pairs);
+        key = key * 2 + static_cast<std::size_t>(state.pair_open);
+        return key * max_remaining + remaining - 1;
+    }
+
+    std::array<answer, alphabet_size * 3 * 2 * 3 * 2 * max_remaining>
+        known_{};
+};
 
 password_t sv_to_password(std::string_view input)
 {
     password_t out;
-    // TODO: Check input
+    if (input.size() != out.size() ||
+        !r::all_of(input, [](char c) { return c >= 'a' && c <= 'z'; })) {
+        throw input_error{
+            fmt::format("Expected 8 lowercase letters, got \"{}\"", input)};
+    }
     r::copy(input, out.begin());
     return out;
 }
 
-bool check_increasing_straight(password_t password)
-{
-    const auto windows{password | rv::sliding(3)};
-    return r::any_of(windows, [](const auto window) {
-        return (window[1] == window[0] + 1) && (window[2] == window[0] + 2);
-    });
-}
-
-bool check_disallowed_letters(password_t password)
+std::string password_to_string(password_t password)
 {
-    return r::none_of(password, [](const char c) {
-        return c == 'i' || c == 'o' || c == 'l';
-    });
+    return password | r::to<std::string>;
 }
 
-bool check_two_pairs(password_t password)
+// The smallest valid password after `password`.  This keeps the longest
+// prefix it can and raises the letter after it by as little as possible,
+// which is the next letter unless that leaves the rules unsatisfiable in the
+// letters left over.  A prefix holding a disallowed letter can't be kept, so
+// one at position k jumps straight to raising position k.
+password_t next_valid_password(password_t password,
+                               completion_search& search)
 {
-    int count{0};
-    const auto stop_iter{std::prev(password.end())};
-    for (auto iter{password.begin()}; iter < stop_iter; iter++) {
-        if (*iter == *std::next(iter)) {
-            count++;
-            iter++;
+    std::array<rule_state, std::tuple_size_v<password_t>> prefix_states;
+    std::size_t allowed_prefix{0};
+    rule_state state;
+    for (const char c : password) {
+        const int letter{c - 'a'};
+        prefix_states[allowed_prefix] = state;
+        allowed_prefix++;
+        if (is_disallowed(letter)) {
+            break;
         }
+        state = state.then(letter);
     }
-    return count >= 2;
-}
-
-bool check_valid_password(password_t password)
-{
-    return check_increasing_straight(password) &&
-           check_disallowed_letters(password) && check_two_pairs(password);
-}
 
-std::string password_to_string(password_t password)
-{
-    return password | r::to<std::string>;
-}
-
-password_t next_valid_password(password_t password)
-{
-    auto num{password_to_number(password)};
-    do {
-        num++;
-        password = number_to_password(num);
-    } while (!check_valid_password(password));
-    return password;
+    for (std::size_t k{allowed_prefix}; k-- > 0;) {
+        for (int letter{password[k] - 'a' + 1}; letter < alphabet_size;
+             letter++) {
+            if (is_disallowed(letter)) {
+                continue;
+            }
+            const auto next{prefix_states[k].then(letter)};
+            const auto remaining{password.size() - k - 1};
+            if (search.possible(next, remaining)) {
+                password[k] = static_cast<char>('a' + letter);
+                search.complete(next, std::span{password}.subspan(k + 1));
+                return password;
+            }
+        }
+    }
+    throw solution_error{fmt::format("No valid password after {}",
+                                     password_to_string(password))};
 }
 
 }  // namespace
@@ -104,8 +193,9 @@ aoc::solution_result day11(std::string_view input)
 {
     input = trim(input);
     const auto password{sv_to_password(input)};
-    const auto next_password{next_valid_password(password)};
-    const auto next_next_password{next_valid_password(next_password)};
+    completion_search search;
+    const auto next_password{next_valid_password(password, search)};
+    const auto next_next_password{next_valid_password(next_password, search)};
 
     return {password_to_string(next_password),
             password_to_string(next_next_password)};
@@ -6,14 +6,9 @@
 //
 
 #include <aoc.hpp>
-#include <aoc_range.hpp>
-
-#include <fmt/format.h>
-
-#include <ctre.hpp>
-
-#include <nlohmann/json.hpp>
+#include <aoc_json.hpp>
 
+#include <array>
 #include <cstdint>
 #include <string_view>
 
@@ -21,90 +16,70 @@ namespace aoc::year2015 {
 
 namespace {
 
-using json_number_t = std::uint64_t;
-
-json_number_t part1(std::string_view input)
-{
-    // XXX The ctre::range docs say this API might change.  If the build fails
-    // here, go see what it changed to.
-    constexpr auto& pattern{
-        R"((\-?)(0|(?:[1-9]\d*))(\.\d+)?([eE][\+\-]?\d+)?)"};
-    const auto range{ctre::range<pattern>(input)};
-    // XXX All the input numbers are ints, but I wrote the above regex to
-    // support any JSON number before I realized that.
-
-    using match_type = decltype(*range.begin());
-    const auto match_to_int{
-        [](match_type match) { return to_int(match.get<0>().to_view()); }};
-    auto int_range{range | rv::transform(match_to_int)};
-    return r::accumulate(int_range, json_number_t{});
-}
-
-// Part One could be solved simply by extracting all the ints from the text file
-// and ignoring the structure, but Part Two sadistically requires some amount of
-// actual parsing.  Rather than parse it ourselves, we'll use a library.
+using json_number_t = std::int64_t;
 
-// Exception thrown by solutions on unexpected JSON contents.
-class json_input_error : public std::runtime_error {
+// Part One could be solved simply by extracting all the ints from the text
+// file and ignoring the structure, but Part Two sadistically requires some
+// amount of actual parsing.  Both are summed in one pass of the JSON scanner,
+// keeping a partial sum per open array or object; when an object closes, its
+// sum is added to its parent's unless one of its values was "red".
+class number_summer {
    public:
-    json_input_error(std::string msg) : runtime_error{std::move(msg)} {}
-};
-
-bool is_red(const nlohmann::json& value)
-{
-    if (!value.is_string()) {
-        return false;
-    }
-    return value.get<std::string>() == "red";
-}
-
-json_number_t sum_tree(const nlohmann::json& json);
-
-json_number_t sum_object(const nlohmann::json& object)
-{
-    const auto items{object.items()};
-    const auto values{items |
-                      rv::transform([](auto item) { return item.value(); })};
-    if (r::any_of(values, is_red)) {
-        // If any member is "red", ignore this whole object
-        return json_number_t{};
+    void begin_object() { push(true); }
+    void begin_array() { push(false); }
+    void end_object() { pop(); }
+    void end_array() { pop(); }
+
+    void number(std::string_view text)
+    {
+        // All the input numbers are ints.
+        const auto n{to_num<json_number_t>(text)};
+        total_ += n;
+        levels_[depth_].sum += n;
     }
-    return r::accumulate(values | rv::transform(sum_tree), json_number_t{});
-}
 
-json_number_t sum_tree(const nlohmann::json& json)
-{
-    if (json.is_array()) {
-        return r::accumulate(json | rv::transform(sum_tree), json_number_t{});
-    }
-    else if (json.is_number()) {
-        return json.get<json_number_t>();
-    }
-    else if (json.is_object()) {
-        return sum_object(json);
-    }
-    else if (json.is_string()) {
-        return json_number_t{};  // 0
+    void string(std::string_view raw)
+    {
+        auto& current{levels_[depth_]};
+        if (current.object && raw == "red") {
+            current.red = true;
+        }
     }
 
-    throw json_input_error{"JSON included some type we don't handle"};
-}
-
-json_number_t part2(std::string_view input)
-{
-    const auto parsed_json = nlohmann::json::parse(input);
-    if (!parsed_json.is_object()) {
-        throw json_input_error{"JSON input is unexpectedly not an object"};
+    json_number_t total() const { return total_; }
+    json_number_t total_without_red() const { return levels_[0].sum; }
+
+   private:
+    struct level {
+        json_number_t sum;
+        bool object;
+        bool red;
+    };
+
+    // The document itself is level 0, so this is one more than the deepest
+    // nesting the scanner accepts.
+    std::array<level, json::max_depth + 1> levels_{};
+    std::size_t depth_{0};
+    json_number_t total_{0};
+
+    void push(bool object) { levels_[++depth_] = {0, object, false}; }
+
+    void pop()
+    {
+        const auto& closed{levels_[depth_--]};
+        if (!closed.red) {
+            levels_[depth_].sum += closed.sum;
+        }
     }
-
-    return sum_tree(parsed_json);
-}
+};
 
 }  // namespace
 
 aoc::solution_result day12(std::string_view input)
 {
-    return {part1(input), part2(input)};
+    number_summer summer;
+    json::scan(input, summer);
+    return {summer.total(), summer.total_without_red()};
 }
 
 }  // namespace aoc::year2015
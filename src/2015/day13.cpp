@@ -7,11 +7,12 @@
 
 #include <aoc.hpp>
 #include <aoc_range.hpp>
+#include <aoc_tsp.hpp>
 
 #include <ctre.hpp>
 
+#include <cstddef>
 #include <cstdint>
-#include <map>
 #include <set>
 #include <string_view>
 
@@ -25,12 +26,9 @@ using happiness_t = std::int32_t;
 struct neighbors {
     name_t self;
     name_t other;
-
-    friend auto operator<=>(const neighbors&, const neighbors&) = default;
 };
 
 using entry_t = std::pair<neighbors, happiness_t>;
-using neighbor_map_t = std::map<neighbors, happiness_t>;
 
 entry_t parse_line(std::string_view line)
 {
@@ -44,57 +42,44 @@ entry_t parse_line(std::string_view line)
     throw input_error{fmt::format("failed to parse input: {}", line)};
 }
 
-happiness_t permutation_score(const std::vector<name_t>& permutation,
-                              const neighbor_map_t& scores)
-{
-    const auto pairs{permutation | rv::cycle |
-                     rv::take(permutation.size() + 1) | rv::sliding(2)};
-    const auto pair_cost{[&scores](decltype(r::front(pairs)) pair) {
-        return scores.at({pair[0], pair[1]}) + scores.at({pair[1], pair[0]});
-    }};
-    return r::accumulate(pairs | rv::transform(pair_cost), 0);
-}
-
 }  // namespace
 
 aoc::solution_result day13(std::string_view input)
 {
-    // XXX This solution simply exhaustively searches all permutations of the
-    // seating arrangement.  It is not particularly fast but it is fast enough
-    // and if there's a much smarter solution, it didn't jump out at me
-    // immediately.  There are plenty of optimizations that could be done
-    // though, like replacing the bidirectional map entries with a single entry
-    // for a sorted pair that's the sum of the two, or even converting names to
-    // ints and using a lookup table in a vector.
-
     const auto lines{sv_lines(trim(input))};
-    neighbor_map_t neighbor_map{lines | rv::transform(parse_line) |
-                                r::to<neighbor_map_t>};
+    const auto entries{lines | rv::transform(parse_line) | r::to<std::vector>};
+
+    const auto people{entries | rv::transform([](const entry_t& entry) {
+                          return entry.first.self;
+                      }) |
+                      r::to<std::set> | r::to<std::vector>};
+    const auto index{[&people](name_t name) {
+        const auto found{r::lower_bound(people, name)};
+        if (found == people.end() || *found != name) {
+            throw input_error{fmt::format("{} has no preferences", name)};
+        }
+        return static_cast<std::size_t>(r::distance(people.begin(), found));
+    }};
 
-    auto people{neighbor_map | rv::keys | rv::transform([](neighbors n) {
-                    return std::array{n.self, n.other};
-                }) |
-                rv::join | r::to<std::set> | r::to<std::vector>};
+    // Seating two people together changes both of their happiness, so the
+    // cost of the pair is the sum of the two, the same in either direction.
+    tsp::distance_matrix<happiness_t> pair_happiness{people.size()};
+    for (const auto& [pair, happiness] : entries) {
+        const auto a{index(pair.self)};
+        const auto b{index(pair.other)};
+        pair_happiness(a, b) += happiness;
+        pair_happiness(b, a) += happiness;
+    }
 
     // Part 1
-    const auto score{[&neighbor_map](const std::vector<name_t>& permutation) {
-        return permutation_score(permutation, neighbor_map);
-    }};
-    const auto part1_max{
-        r::max(permutation_generator(people) | rv::transform(score))};
+    const auto part1_max{tsp::solve(pair_happiness, tsp::route::cycle,
+                                    tsp::objective::maximize)};
 
     // Part 2
-    // Add ourselves to the list of people and the map
-    const std::string_view my_name{"Santa's Helper"};
-    people.push_back("Santa's Helper");
-    for (const auto [a, b] : people | rv::transform([&](auto name) {
-                                 return neighbors{name, my_name};
-                             })) {
-        neighbor_map.insert({{a, b}, {}});
-        neighbor_map.insert({{b, a}, {}});
-    }
-    const auto part2_max{
-        r::max(permutation_generator(people) | rv::transform(score))};
+    // Sitting ourselves down, indifferent to and ignored by everyone, breaks
+    // the table into a line of everyone else.
+    const auto part2_max{tsp::solve(pair_happiness, tsp::route::path,
+                                    tsp::objective::maximize)};
 
     return {part1_max, part2_max};
 }
@@ -6,11 +6,10 @@
 //
 
 #include <aoc.hpp>
-#include <aoc_range.hpp>
+#include <aoc_divisor_sieve.hpp>
 
 #include <cstdint>
 #include <string_view>
-#include <vector>
 
 namespace aoc::year2015 {
 
@@ -18,41 +17,26 @@ namespace {
 
 using int_t = std::uint64_t;
 
+// The first house with at least `target` presents, when each elf delivers
+// `per_elf` times its number to each house it visits.
+int_t first_house(int_t target, int_t per_elf,
+                  const divisor_sigma_sieve& sieve)
+{
+    return sieve.find_first((target + per_elf - 1) / per_elf);
+}
+
 }  // namespace
 
 aoc::solution_result day20(std::string_view input)
 {
     const auto input_num{to_num<int_t>(trim(input))};
-    const auto max_house{input_num / 20};
-    std::vector<int_t> present_counts;
-    present_counts.resize(max_house + 1);
-
-    const auto check_house{[=](int_t count) { return count >= input_num; }};
-    const auto find_house{
-        [&] { return r::find_if(present_counts, check_house); }};
-    const auto find_house_num{
-        [&] { return r::distance(present_counts.begin(), find_house()); }};
-
-    // Naive simulation
-    for (int_t elf{1}; elf <= max_house; elf++) {
-        for (int_t house{elf}; house <= max_house; house += elf) {
-            present_counts[house] += elf * 10;
-        }
-    }
-    const auto part1_house{find_house_num()};
-
-    present_counts.clear();
-    present_counts.resize(max_house + 1);
-
-    // Naive simulation
-    for (int_t elf{1}; elf <= max_house; elf++) {
-        int_t visit{0};
-        for (int_t house{elf}; house <= max_house && visit < 50;
-             house += elf, visit++) {
-            present_counts[house] += elf * 11;
-        }
-    }
-    const auto part2_house{find_house_num()};
+
+    // Elf e visits the multiples of e, so a house gets presents from each of
+    // its divisors.
+    const auto part1_house{first_house(input_num, 10, divisor_sigma_sieve{})};
+    // In part 2, each elf stops after 50 houses.
+    const auto part2_house{
+        first_house(input_num, 11, divisor_sigma_sieve{50})};
 
     return {part1_house, part2_house};
 }
@@ -6,441 +6,303 @@
 //
 
 #include <aoc.hpp>
-#include <aoc_graph.hpp>
+#include <aoc_flat_hash.hpp>
 #include <aoc_range.hpp>
 
+#include <fmt/format.h>
+
 #include <algorithm>
-#include <cassert>
-#include <map>
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
-#include <string>
 #include <string_view>
-#include <tuple>
-#include <typeindex>
-#include <utility>
+#include <vector>
 
 namespace aoc::year2015 {
 
 namespace {
 
-class effect;
-using effect_map = std::map<std::type_index, std::unique_ptr<effect>>;
+using cost_t = int;
 
-std::weak_ordering compare_effects(const effect_map::value_type& l,
-                                   const effect_map::value_type& r);
+constexpr int player_start_hit_points{50};
+constexpr int player_start_mana{500};
+constexpr int max_hit_points{std::numeric_limits<std::uint8_t>::max()};
 
-struct stats {
-    std::string name;
+struct boss_stats {
     int hit_points;
-    int mana;
     int damage;
-    int armor;
-    effect_map active_effects;
-
-    stats(std::string name_,
-          int hit_points_,
-          int mana_,
-          int damage_,
-          int armor_)
-        : name{name_},
-          hit_points{hit_points_},
-          mana{mana_},
-          damage{damage_},
-          armor{armor_},
-          active_effects{}
-    {
-    }
-    stats(const stats& s);
-    stats& operator=(const stats& s);
-    void add_effect(std::unique_ptr<effect>&& e);
-    void apply_effects();
-    bool dead() const noexcept { return hit_points <= 0; }
-
-   private:
-    auto tie_() const noexcept
-    {
-        return std::tie(name, hit_points, mana, damage, armor);
-    }
-
-   public:
-    friend std::weak_ordering operator<=>(const stats& l,
-                                          const stats& r) noexcept
-    {
-        const auto first_result{l.tie_() <=> r.tie_()};
-        if (first_result != 0) {
-            return first_result;
-        }
-        return std::lexicographical_compare_three_way(
-            l.active_effects.begin(), l.active_effects.end(),
-            r.active_effects.begin(), r.active_effects.end(), compare_effects);
-    };
-    [[maybe_unused]] friend bool operator==(const stats& l,
-                                            const stats& r) noexcept
-    {
-        return (l <=> r) == 0;
-    };
 };
 
-class effect {
-   public:
-    virtual ~effect() noexcept = default;
-
-    void cast() { cast_(); }
-    void apply()
-    {
-        if (timer_ > 0) {
-            apply_();
-        }
-        timer_--;
-    }
-    void finish() { finish_(); }
-    virtual std::unique_ptr<effect> clone(stats* new_target) = 0;
-    int timer() const noexcept { return timer_; };
-    friend auto operator<=>(const effect& l, const effect& r) noexcept
-    {
-        const std::type_index l_id{typeid(l)};
-        const std::type_index r_id{typeid(r)};
-        return std::tie(l_id, l.timer_) <=> std::tie(r_id, l.timer_);
+boss_stats parse_input(std::string_view input)
+{
+    const auto lines{sv_lines(input) | r::to<std::vector>};
+    if (lines.size() < 2) {
+        throw input_error{"expected the boss's hit points and damage"};
     }
-    [[maybe_unused]] friend bool operator==(const effect& l,
-                                            const effect& r) noexcept
-    {
-        const std::type_index l_id{typeid(l)};
-        const std::type_index r_id{typeid(r)};
-        return std::tie(l_id, l.timer_) == std::tie(r_id, l.timer_);
+    const boss_stats boss{
+        to_int(lines[0].substr(lines[0].find_last_of(' ') + 1)),
+        to_int(lines[1].substr(lines[1].find_last_of(' ') + 1))};
+    if (boss.hit_points <= 0 || boss.hit_points > max_hit_points) {
+        throw input_error{
+            fmt::format("boss hit points out of range: {}", boss.hit_points)};
     }
+    return boss;
+}
 
-   protected:
-    explicit effect(stats* target, int turns) : target_{target}, timer_(turns)
-    {
-    }
-    virtual void cast_() {}
-    virtual void apply_() {}
-    virtual void finish_() {}
-    stats* target_;
-    int timer_;
+enum class spell : std::uint8_t {
+    magic_missile,
+    drain,
+    shield,
+    poison,
+    recharge
 };
 
-class shield final : public effect {
-   public:
-    explicit shield(stats* target, int turns = 6) : effect{target, turns} {}
-    virtual std::unique_ptr<effect> clone(stats* new_target) override
-    {
-        return std::make_unique<shield>(new_target, timer_);
-    }
-
-   protected:
-    virtual void cast_() override { target_->armor += 7; }
-    virtual void finish_() override { target_->armor -= 7; }
+constexpr std::array spells{spell::magic_missile, spell::drain, spell::shield,
+                            spell::poison, spell::recharge};
+constexpr std::array<cost_t, spells.size()> spell_costs{53, 73, 113, 173, 229};
+
+// Turns each effect lasts, which is also the range of its timer.
+constexpr int shield_turns{6};
+constexpr int poison_turns{6};
+constexpr int recharge_turns{5};
+
+// Everything that changes during a battle, at the point where the player
+// chooses a spell.  Armor follows from the shield timer and the boss's damage
+// never changes, so neither is stored.
+struct battle_state {
+    std::uint8_t player_hit_points;
+    std::uint8_t boss_hit_points;
+    std::uint16_t mana;
+    std::uint8_t shield_timer;
+    std::uint8_t poison_timer;
+    std::uint8_t recharge_timer;
 };
+static_assert(sizeof(battle_state) == 8);
 
-class poison final : public effect {
-   public:
-    explicit poison(stats* target, int turns = 6) : effect{target, turns} {}
-    virtual std::unique_ptr<effect> clone(stats* new_target) override
-    {
-        return std::make_unique<poison>(new_target, timer_);
-    }
+enum class outcome { undecided, won, lost };
 
-   protected:
-    virtual void apply_() override { target_->hit_points -= 3; }
-};
+enum class game_difficulty { normal, hard };
 
-class recharge final : public effect {
+class battle {
    public:
-    explicit recharge(stats* target, int turns = 5) : effect{target, turns} {}
-    virtual std::unique_ptr<effect> clone(stats* new_target) override
+    battle(boss_stats boss, game_difficulty difficulty)
+        : boss_damage_{boss.damage}, difficulty_{difficulty}
     {
-        return std::make_unique<recharge>(new_target, timer_);
     }
 
-   protected:
-    virtual void apply_() override { target_->mana += 101; }
-};
+    // Cast `s`, then play out the boss's turn and the start of the player's
+    // next, up to their next choice.
+    outcome run_turn(battle_state& state, spell s) const
+    {
+        int player{state.player_hit_points};
+        int boss{state.boss_hit_points};
+        int mana{state.mana - spell_costs[static_cast<std::size_t>(s)]};
+
+        switch (s) {
+            case spell::magic_missile:
+                boss -= 4;
+                break;
+            case spell::drain:
+                boss -= 2;
+                player += 2;
+                break;
+            case spell::shield:
+                state.shield_timer = shield_turns;
+                break;
+            case spell::poison:
+                state.poison_timer = poison_turns;
+                break;
+            case spell::recharge:
+                state.recharge_timer = recharge_turns;
+                break;
+        }
+        if (boss <= 0) {
+            return outcome::won;
+        }
 
-std::weak_ordering compare_effects(const effect_map::value_type& l,
-                                   const effect_map::value_type& r)
-{
-    const auto& [l_id, l_ptr]{l};
-    const auto& [r_id, r_ptr]{r};
-    return std::tie(l_id, *l_ptr) <=> std::tie(r_id, *r_ptr);
-}
+        // Boss turn
+        apply_effects(state, boss, mana);
+        if (boss <= 0) {
+            return outcome::won;
+        }
+        const int armor{state.shield_timer > 0 ? 7 : 0};
+        player -= std::max(1, boss_damage_ - armor);
+        if (difficulty_ == game_difficulty::hard) {
+            player--;
+        }
+        if (player <= 0) {
+            return outcome::lost;
+        }
 
-stats::stats(const stats& s)
-    : stats{s.name, s.hit_points, s.mana, s.damage, s.armor}
-{
-    for (const auto& [id, e] : s.active_effects) {
-        active_effects.emplace(id, e->clone(this));
-    }
-    assert(s == *this);
-}
+        // Beginning of player's next turn
+        apply_effects(state, boss, mana);
+        if (boss <= 0) {
+            return outcome::won;
+        }
 
-stats& stats::operator=(const stats& s)
-{
-    name = s.name;
-    hit_points = s.hit_points;
-    mana = s.mana;
-    damage = s.damage;
-    armor = s.armor;
-    active_effects.clear();
-    for (const auto& [id, e] : s.active_effects) {
-        active_effects.emplace(id, e->clone(this));
+        if (player > max_hit_points ||
+            mana > std::numeric_limits<std::uint16_t>::max()) {
+            throw solution_error{"battle state outgrew its fields"};
+        }
+        state.player_hit_points = static_cast<std::uint8_t>(player);
+        state.boss_hit_points = static_cast<std::uint8_t>(boss);
+        state.mana = static_cast<std::uint16_t>(mana);
+        return outcome::undecided;
     }
-    assert(s == *this);
-    return *this;
-}
 
-void stats::add_effect(std::unique_ptr<effect>&& e)
-{
-    e->cast();
-    auto& e_val{*e};
-    const auto id{std::type_index(typeid(e_val))};
-    if (!active_effects.contains(id)) {
-        active_effects.emplace(id, std::move(e));
-    }
-}
+   private:
+    int boss_damage_;
+    game_difficulty difficulty_;
 
-void stats::apply_effects()
-{
-    std::vector<std::type_index> effects_to_erase;
-    for (const auto& [id, e] : active_effects) {
-        e->apply();
-        if (e->timer() == 0) {
-            e->finish();
-            effects_to_erase.push_back(id);
+    static void apply_effects(battle_state& state, int& boss, int& mana)
+    {
+        if (state.shield_timer > 0) {
+            state.shield_timer--;
+        }
+        if (state.poison_timer > 0) {
+            boss -= 3;
+            state.poison_timer--;
+        }
+        if (state.recharge_timer > 0) {
+            mana += 101;
+            state.recharge_timer--;
         }
     }
-    for (const auto& id : effects_to_erase) {
-        active_effects.erase(id);
-    }
-}
-
-struct game_state {
-    stats player;
-    stats boss;
-    friend auto operator<=>(const game_state&, const game_state&) = default;
 };
 
-void cast_magic_missile(stats& /*caster*/, stats& enemy)
-{
-    enemy.hit_points -= 4;
-}
-
-void cast_drain(stats& caster, stats& enemy)
+bool can_cast(const battle_state& state, spell s)
 {
-    // fmt::print(
-    caster.hit_points += 2;
-    enemy.hit_points -= 2;
-}
-
-void cast_shield(stats& caster, stats& /*enemy*/)
-{
-    caster.add_effect(std::make_unique<shield>(&caster));
-}
-
-void cast_poison(stats& /*caster*/, stats& enemy)
-{
-    enemy.add_effect(std::make_unique<poison>(&enemy));
-}
-
-void cast_recharge(stats& caster, stats& /*enemy*/)
-{
-    caster.add_effect(std::make_unique<recharge>(&caster));
-}
-
-void attack(const stats& attacker, stats& target)
-{
-    const int damage{std::max(1, attacker.damage - target.armor)};
-    target.hit_points -= damage;
-}
-
-using cost_t = int;
-using spell_signature = decltype(&cast_magic_missile);
-
-enum class effect_target { self, enemy };
-
-struct effect_info {
-    std::type_index id;
-    effect_target target;
-};
-
-struct spell {
-    cost_t cost;
-    spell_signature func;
-    std::optional<effect_info> effect_info_;
-};
-
-const spell def_magic_missile{53, cast_magic_missile, {}};
-const spell def_drain{73, cast_drain, {}};
-const spell def_shield{113,
-                       cast_shield,
-                       {{typeid(shield), effect_target::self}}};
-const spell def_poison{173,
-                       cast_poison,
-                       {{typeid(poison), effect_target::enemy}}};
-const spell def_recharge{229,
-                         cast_recharge,
-                         {{typeid(recharge), effect_target::self}}};
-
-const std::array<spell, 5> spell_list{
-    {def_magic_missile, def_drain, def_shield, def_poison, def_recharge}};
-
-auto allowed_spells(const game_state& state)
-{
-    return spell_list | rv::filter([&](const spell& s) {
-               const auto& [player, boss]{state};
-               if (s.cost > player.mana) {
-                   // Not enough mana to cast this spell.
-                   return false;
-               }
-               if (!s.effect_info_) {
-                   // This spell causes no effect.
-                   return true;
-               }
-               const auto& [cost, func, info]{s};
-               const auto& [id, target]{*info};
-               const auto& active_effects{target == effect_target::self
-                                              ? player.active_effects
-                                              : boss.active_effects};
-               const auto found_effect{active_effects.find(id)};
-               if (found_effect == active_effects.end()) {
-                   // Effect is not active
-                   return true;
-               }
-               // Whether effect wore off or will this turn
-               return found_effect->second->timer() <= 0;
-           });
-}
-
-stats parse_input(std::string_view input)
-{
-    const auto lines{sv_lines(input) | r::to<std::vector>};
-    return {"Boss", to_int(lines[0].substr(lines[0].find_last_of(' ') + 1)), 0,
-            to_int(lines[1].substr(lines[1].find_last_of(' ') + 1)), 0};
-}
-
-enum class game_difficulty { normal, hard };
-
-game_state run_turn(const game_state& state,
-                    const spell& player_spell,
-                    const game_difficulty difficulty)
-{
-    game_state out{state};
-    auto& [player, boss]{out};
-    const auto& [cost, spell_func, id]{player_spell};
-
-    // We start in the middle of the player's turn at the point where they make
-    // a decision.
-    spell_func(player, boss);
-    player.mana -= cost;
-    if (player.dead() || boss.dead()) {
-        return out;
-    }
-
-    // Boss turn
-    player.apply_effects();
-    if (player.dead() || boss.dead()) {
-        return out;
-    }
-    boss.apply_effects();
-    if (player.dead() || boss.dead()) {
-        return out;
-    }
-    attack(boss, player);
-    if (player.dead() || boss.dead()) {
-        return out;
-    }
-
-    // Beginning of player's next turn
-    if (difficulty == game_difficulty::hard) {
-        player.hit_points--;
+    if (spell_costs[static_cast<std::size_t>(s)] > state.mana) {
+        return false;
     }
-    if (player.dead() || boss.dead()) {
-        return out;
+    switch (s) {
+        case spell::shield:
+            return state.shield_timer == 0;
+        case spell::poison:
+            return state.poison_timer == 0;
+        case spell::recharge:
+            return state.recharge_timer == 0;
+        default:
+            return true;
     }
+}
 
-    player.apply_effects();
-    if (player.dead() || boss.dead()) {
-        return out;
+// Most mana of any state reached so far with the same hit points and timers.
+// More mana never hurts, so when states come out of the queue in order of mana
+// spent, one with no more mana than an earlier state which matches it
+// otherwise can be dropped.  This is also what stops a state being expanded
+// twice.  Only a thousand or so of the possible keys are ever reached, so
+// they are hashed rather than given a slot each.
+class mana_table {
+   public:
+    // Record `state` unless an earlier state dominates it.
+    bool improve(const battle_state& state)
+    {
+        const auto [iter, inserted]{most_mana_.try_emplace(key(state),
+                                                           state.mana)};
+        if (inserted) {
+            return true;
+        }
+        if (state.mana <= iter->second) {
+            return false;
+        }
+        iter->second = state.mana;
+        return true;
     }
-    boss.apply_effects();
 
-    // At this point the player makes their next decision.
-    return out;
-}
+   private:
+    flat_hash_map<std::uint32_t, std::uint16_t> most_mana_;
 
-struct game_queue_entry {
-    game_state vert;
-    int dist;
-    friend auto operator<=>(const game_queue_entry& lhs,
-                            const game_queue_entry& rhs) noexcept
+    // Everything but the mana, packed into bits.
+    static std::uint32_t key(const battle_state& s) noexcept
     {
-        return lhs.dist <=> rhs.dist;
+        return static_cast<std::uint32_t>(s.player_hit_points) << 24 |
+               static_cast<std::uint32_t>(s.boss_hit_points) << 16 |
+               static_cast<std::uint32_t>(s.shield_timer) << 8 |
+               static_cast<std::uint32_t>(s.poison_timer) << 4 |
+               s.recharge_timer;
     }
 };
 
-struct game_state_graph {
-    using vertex_type = game_state;
-    using cost_type = int;
-    using queue_entry = game_queue_entry;
+// Dijkstra's algorithm over mana spent, with a queue of buckets, one per
+// cost.  Every spell costs at most the dearest one, so the open states never
+// span more than that many costs and the buckets can be reused round-robin.
+// Drained buckets keep their capacity, so after the first few rounds queuing
+// a state allocates nothing.
+cost_t least_mana_to_win(const boss_stats& boss, game_difficulty difficulty)
+{
+    const battle rules{boss, difficulty};
+    battle_state start{player_start_hit_points,
+                       static_cast<std::uint8_t>(boss.hit_points),
+                       player_start_mana,
+                       0,
+                       0,
+                       0};
+    if (difficulty == game_difficulty::hard) {
+        // The first turn's hit point is lost before the first choice.
+        start.player_hit_points--;
+    }
 
-    const game_state root() const
-    {
-        auto out{start_};
-        if (difficulty_ == game_difficulty::hard) {
-            // XXX HACK: Because I defined "run_turn" to start in the middle
-            // of the player's turn instead of the "start" as the
-            // instructions defined it (because the player's decision is
-            // based on information in the middle), the player losing 1 HP
-            // at the beginning of a turn is missed for the first turn, so
-            // do it here.
-            out.player.hit_points--;
+    constexpr auto bucket_count{
+        static_cast<std::size_t>(std::ranges::max(spell_costs)) + 1};
+    std::array<std::vector<battle_state>, bucket_count> buckets;
+    mana_table seen;
+    buckets[0].push_back(start);
+    std::size_t queued{1};
+    std::optional<cost_t> best_win;
+
+    for (cost_t cost{0}; queued > 0 && (!best_win || cost < *best_win);
+         cost++) {
+        auto& bucket{buckets[static_cast<std::size_t>(cost) % bucket_count]};
+        queued -= bucket.size();
+        // Nothing is queued into the current bucket, since every spell costs
+        // something, so it can be walked while the others grow.
+        for (const battle_state& state : bucket) {
+            if (!seen.improve(state)) {
+                continue;
+            }
+            for (const spell s : spells) {
+                if (!can_cast(state, s)) {
+                    continue;
+                }
+                const auto spell_cost{
+                    spell_costs[static_cast<std::size_t>(s)]};
+                const cost_t next_cost{cost + spell_cost};
+                battle_state next{state};
+                switch (rules.run_turn(next, s)) {
+                    case outcome::won:
+                        best_win = std::min(best_win.value_or(next_cost),
+                                            next_cost);
+                        break;
+                    case outcome::lost:
+                        break;
+                    case outcome::undecided:
+                        buckets[static_cast<std::size_t>(next_cost) %
+                                bucket_count]
+                            .push_back(next);
+                        queued++;
+                        break;
+                }
+            }
         }
-        return out;
-    }
-    static bool reject(const vertex_type& v) noexcept
-    {
-        // XXX should reject be in this interface, or just part of
-        // adjacencies?
-        return v.player.dead();
-    }
-    bool accept(const vertex_type& v) const noexcept
-    {
-        return v.boss.dead() && !v.player.dead();
-    }
-    auto adjacencies(const vertex_type& v) const
-    {
-        return allowed_spells(v) | rv::transform([&](const spell& s) {
-                   return queue_entry{run_turn(v, s, difficulty_), s.cost};
-               }) |
-               rv::filter([](const queue_entry& entry) {
-                   return !reject(entry.vert);
-               }) |
-               r::to<std::vector>;
+        bucket.clear();
     }
 
-    const game_state& start_;
-    const game_difficulty difficulty_;
-};
+    if (!best_win) {
+        throw solution_error{"the boss can't be beaten"};
+    }
+    return *best_win;
+}
 
 }  // namespace
 
 aoc::solution_result day22(std::string_view input)
 {
-    const stats boss_stats{parse_input(trim(input))};
-    const stats player_stats{"Player", 50, 500, 0, 0};
-
-    const game_state start{player_stats, boss_stats};
-
-    game_state_graph g1{start, game_difficulty::normal};
-    const auto result1{dijkstra(g1)};
-    const auto part1_result{result1.dist.at(*(result1.end))};
-
-    game_state_graph g2{start, game_difficulty::hard};
-    const auto result2{dijkstra(g2)};
-    const auto part2_result{result2.dist.at(*(result2.end))};
-
-    return {part1_result, part2_result};
+    const boss_stats boss{parse_input(trim(input))};
+    return {least_mana_to_win(boss, game_difficulty::normal),
+            least_mana_to_win(boss, game_difficulty::hard)};
 }
+
 }  // namespace aoc::year2015
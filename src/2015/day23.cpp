@@ -10,8 +10,12 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <limits>
 #include <string_view>
+#include <vector>
 
 namespace aoc::year2015 {
 
@@ -20,7 +24,6 @@ namespace {
 // XXX The instructions say a register can hold "any non-negative integer" but
 // I'm going to cross my fingers that uint64_t is good enough.
 using word = std::uint64_t;
-using instruction = std::string_view;
 
 enum class reg_name { a, b };
 reg_name reg_name_from_char(char c)
@@ -35,89 +38,179 @@ reg_name reg_name_from_char(char c)
     }
 }
 
-struct cpu {
-    cpu(const std::vector<instruction> program) : program_{program} {}
+enum class opcode {
+    hlf,
+    tpl,
+    inc,
+    jmp,
+    jie,
+    jio,
+    // Not in the puzzle's instruction set: a whole Collatz loop, found by
+    // `collapse_collatz_loops`.
+    collatz,
+};
 
-    std::array<word, 2> registers{};
-    int inst_ptr_{0};
-    std::vector<instruction> program_;
+// An instruction decoded once, before the program runs.  Jumps hold their
+// target rather than their offset.
+struct instruction {
+    opcode op;
+    reg_name r{reg_name::a};
+    // For `collatz`, the register counting the steps.
+    reg_name counter{reg_name::a};
+    int target{0};
+};
 
-    word& reg(reg_name r) { return registers[static_cast<std::size_t>(r)]; }
-    reg_name to_reg(char c) { return reg_name_from_char(c); }
+int parse_offset(std::string_view s)
+{
+    if (s.size() < 2 || (s[0] != '+' && s[0] != '-')) {
+        throw input_error(fmt::format("Invalid offset {}", s));
+    }
+    const int sign{s[0] == '+' ? 1 : -1};
+    return sign * to_int(s.substr(1));
+}
 
-    void run()
-    {
-        while (inst_ptr_ >= 0 &&
-               inst_ptr_ < static_cast<std::int64_t>(program_.size())) {
-            run_instruction();
-        }
+instruction decode(std::string_view i, int address)
+{
+    if (i.size() < 5) {
+        throw input_error(fmt::format("Invalid instruction {}", i));
+    }
+    const auto name{i.substr(0, 3)};
+    if (name == "hlf") {
+        return {opcode::hlf, reg_name_from_char(i[4])};
     }
+    else if (name == "tpl") {
+        return {opcode::tpl, reg_name_from_char(i[4])};
+    }
+    else if (name == "inc") {
+        return {opcode::inc, reg_name_from_char(i[4])};
+    }
+    else if (name == "jmp") {
+        return {opcode::jmp, {}, {}, address + parse_offset(i.substr(4))};
+    }
+    else if (name == "jie" && i.size() > 7) {
+        return {opcode::jie, reg_name_from_char(i[4]), {},
+                address + parse_offset(i.substr(7))};
+    }
+    else if (name == "jio" && i.size() > 7) {
+        return {opcode::jio, reg_name_from_char(i[4]), {},
+                address + parse_offset(i.substr(7))};
+    }
+    throw input_error(fmt::format("Invalid instruction {}", i));
+}
 
-    void run_instruction()
-    {
-        const auto i{program_[static_cast<std::size_t>(inst_ptr_)]};
-        auto parse_offset{[&](std::size_t offset) {
-            int sign{i[offset] == '+' ? 1 : -1};
-            return sign * to_int(i.substr(offset + 1));
+// The programs spend nearly all their time in a loop which counts the steps
+// for the register `r` to reach 1 under the Collatz map:
+//
+//      jio r, +8
+//      inc n
+//      jie r, +4
+//      tpl r
+//      inc r
+//      jmp +2
+//      hlf r
+//      jmp -7
+//
+// Replace the first instruction of each such loop with one `collatz`
+// instruction which does the same.  The rest are left in place, in case
+// anything jumps into the middle of the loop.
+void collapse_collatz_loops(std::vector<instruction>& program)
+{
+    constexpr std::size_t loop_size{8};
+    for (std::size_t pc{0}; pc + loop_size <= program.size(); pc++) {
+        const auto* i{program.data() + pc};
+        const int start{static_cast<int>(pc)};
+        const reg_name r{i[0].r};
+        const reg_name n{i[1].r};
+        const auto is{[r](const instruction& inst, opcode op) {
+            return inst.op == op && inst.r == r;
         }};
-
-        if (i.starts_with("hlf")) {
-            inst_hlf(to_reg(i[4]));
-        }
-        else if (i.starts_with("tpl")) {
-            inst_tpl(to_reg(i[4]));
-        }
-        else if (i.starts_with("inc")) {
-            inst_inc(to_reg(i[4]));
-        }
-        else if (i.starts_with("jmp")) {
-            inst_jmp(parse_offset(4));
-        }
-        else if (i.starts_with("jie")) {
-            inst_jie(to_reg(i[4]), parse_offset(7));
-        }
-        else if (i.starts_with("jio")) {
-            inst_jio(to_reg(i[4]), parse_offset(7));
+        if (is(i[0], opcode::jio) && i[0].target == start + 8 &&
+            i[1].op == opcode::inc && n != r && is(i[2], opcode::jie) &&
+            i[2].target == start + 6 && is(i[3], opcode::tpl) &&
+            is(i[4], opcode::inc) && i[5].op == opcode::jmp &&
+            i[5].target == start + 7 && is(i[6], opcode::hlf) &&
+            i[7].op == opcode::jmp && i[7].target == start) {
+            program[pc] = {opcode::collatz, r, n, start + 8};
         }
     }
+}
 
-    void inst_hlf(reg_name r)
-    {
-        reg(r) /= 2;
-        inst_ptr_++;
+std::vector<instruction> compile(std::string_view input)
+{
+    std::vector<instruction> program;
+    for (const auto line : sv_lines(trim(input))) {
+        program.push_back(decode(line, static_cast<int>(program.size())));
     }
+    collapse_collatz_loops(program);
+    return program;
+}
 
-    void inst_tpl(reg_name r)
-    {
-        reg(r) *= 3;
-        inst_ptr_++;
+// Steps for `x` to reach 1, added to `count`.  Runs of halvings are taken
+// at once; the tripling throws rather than wrapping around.
+void collatz(word& x, word& count)
+{
+    while (x != 1) {
+        if (x == 0) {
+            throw solution_error("Collatz loop on zero never ends");
+        }
+        if (x % 2 == 0) {
+            const auto zeroes{std::countr_zero(x)};
+            x >>= zeroes;
+            count += static_cast<word>(zeroes);
+        }
+        else {
+            if (x > (std::numeric_limits<word>::max() - 1) / 3) {
+                throw solution_error("Collatz loop overflows a register");
+            }
+            x = 3 * x + 1;
+            count++;
+        }
     }
+}
 
-    void inst_inc(reg_name r)
+struct cpu {
+    explicit cpu(const std::vector<instruction>& program) : program_{program}
     {
-        reg(r)++;
-        inst_ptr_++;
     }
 
-    void inst_jmp(int offset) { inst_ptr_ += offset; }
+    std::array<word, 2> registers{};
+    const std::vector<instruction>& program_;
 
-    void inst_jie(reg_name r, int offset)
-    {
-        if (reg(r) % 2 == 0) {
-            inst_ptr_ += offset;
-        }
-        else {
-            inst_ptr_++;
-        }
-    }
+    word& reg(reg_name r) { return registers[static_cast<std::size_t>(r)]; }
 
-    void inst_jio(reg_name r, int offset)
+    void run()
     {
-        if (reg(r) == 1) {
-            inst_ptr_ += offset;
-        }
-        else {
-            inst_ptr_++;
+        const auto size{static_cast<int>(program_.size())};
+        int ip{0};
+        while (ip >= 0 && ip < size) {
+            const auto& i{program_[static_cast<std::size_t>(ip)]};
+            switch (i.op) {
+                case opcode::hlf:
+                    reg(i.r) /= 2;
+                    ip++;
+                    break;
+                case opcode::tpl:
+                    reg(i.r) *= 3;
+                    ip++;
+                    break;
+                case opcode::inc:
+                    reg(i.r)++;
+                    ip++;
+                    break;
+                case opcode::jmp:
+                    ip = i.target;
+                    break;
+                case opcode::jie:
+                    ip = reg(i.r) % 2 == 0 ? i.target : ip + 1;
+                    break;
+                case opcode::jio:
+                    ip = reg(i.r) == 1 ? i.target : ip + 1;
+                    break;
+                case opcode::collatz:
+                    collatz(reg(i.r), reg(i.counter));
+                    ip = i.target;
+                    break;
+            }
         }
     }
 };
@@ -126,7 +219,7 @@ struct cpu {
 
 aoc::solution_result day23(std::string_view input)
 {
-    const auto program{sv_lines(trim(input)) | r::to<std::vector>};
+    const auto program{compile(input)};
     cpu c1{program};
     c1.run();
 
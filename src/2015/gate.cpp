@@ -11,11 +11,116 @@
 
 #include <ctre.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <regex>
+#include <span>
+#include <variant>
+#include <vector>
 
 namespace aoc::year2015::gates {
 
+namespace {
+
+// A signal in each of 64 evaluations, bit-sliced: bit `b` of the signal in
+// evaluation `lane` is bit `lane` of `planes[b]`.  The gates become bitwise
+// operations over the 16 planes, which the compiler can vectorize.
+using planes = std::array<std::uint64_t, 16>;
+constexpr std::size_t batch_lanes{64};
+
+planes broadcast(signal s) noexcept
+{
+    planes p;
+    for (std::size_t b{0}; b < p.size(); b++) {
+        p[b] = ((unsigned{s} >> b) & 1U) ? ~std::uint64_t{0} : 0;
+    }
+    return p;
+}
+
+void set_lane(planes& p, std::size_t lane, signal s) noexcept
+{
+    const std::uint64_t bit{std::uint64_t{1} << lane};
+    for (std::size_t b{0}; b < p.size(); b++) {
+        p[b] = ((unsigned{s} >> b) & 1U) ? (p[b] | bit) : (p[b] & ~bit);
+    }
+}
+
+signal get_lane(const planes& p, std::size_t lane) noexcept
+{
+    unsigned s{0};
+    for (std::size_t b{0}; b < p.size(); b++) {
+        s |= static_cast<unsigned>((p[b] >> lane) & 1U) << b;
+    }
+    return static_cast<signal>(s);
+}
+
+// Shifts by a different amount in each lane, as a barrel shifter: stage `j`
+// shifts by 2^j the lanes with bit `j` of the amount set.  Amounts of 16 or
+// more shift everything out.
+template <bool Left>
+planes shift(planes p, const planes& amount) noexcept
+{
+    for (std::size_t j{0}; j < 4; j++) {
+        const std::size_t k{std::size_t{1} << j};
+        const std::uint64_t m{amount[j]};
+        if constexpr (Left) {
+            for (std::size_t b{p.size()}; b-- > 0;) {
+                const std::uint64_t shifted{b >= k ? p[b - k] : 0};
+                p[b] = (m & shifted) | (~m & p[b]);
+            }
+        }
+        else {
+            for (std::size_t b{0}; b < p.size(); b++) {
+                const std::uint64_t shifted{b + k < p.size() ? p[b + k] : 0};
+                p[b] = (m & shifted) | (~m & p[b]);
+            }
+        }
+    }
+    std::uint64_t too_far{0};
+    for (std::size_t b{4}; b < amount.size(); b++) {
+        too_far |= amount[b];
+    }
+    for (auto& plane : p) {
+        plane &= ~too_far;
+    }
+    return p;
+}
+
+planes sliced_gate_op(gate_type type, const planes& i1,
+                      const planes& i2) noexcept
+{
+    planes out;
+    switch (type) {
+        case gate_type::assign:
+            return i1;
+        case gate_type::and_:
+            for (std::size_t b{0}; b < out.size(); b++) {
+                out[b] = i1[b] & i2[b];
+            }
+            return out;
+        case gate_type::or_:
+            for (std::size_t b{0}; b < out.size(); b++) {
+                out[b] = i1[b] | i2[b];
+            }
+            return out;
+        case gate_type::not_:
+            for (std::size_t b{0}; b < out.size(); b++) {
+                out[b] = ~i1[b];
+            }
+            return out;
+        case gate_type::lshift:
+            return shift<true>(i1, i2);
+        case gate_type::rshift:
+            return shift<false>(i1, i2);
+    }
+    std::abort();  // Unreachable
+}
+
+}  // namespace
+
 constexpr std::array<std::string_view, 6> gate_type_sv{
     "ASSIGN", "AND", "OR", "NOT", "LSHIFT", "RSHIFT",
 };
@@ -65,82 +170,248 @@ gate_description gate_from_sv(std::string_view sv)
     throw input_error{fmt::format("Invalid gate description format: {}", sv)};
 }
 
-void circuit::set_signal(wire w, signal s)
+void circuit::set_signal(const wire& w, signal s)
 {
-    computed_signals_.emplace(w, s);
+    const reg r{registers_by_wire_.at(w)};
+    overridden_[r] = true;
+    if (evaluated_ && registers_[r] != s) {
+        changed_[r] = true;
+        first_stale_ = std::min(first_stale_, first_reader_[r]);
+    }
+    registers_[r] = s;
 }
 
-signal circuit::get_signal(wire w) const
+signal circuit::get_signal(const wire& w) const
 {
-    return computed_signals_.at(w);
+    if (!evaluated_) {
+        throw solution_error("circuit has not been evaluated");
+    }
+    return registers_[registers_by_wire_.at(w)];
 }
 
 void circuit::evaluate()
 {
-    for (const auto& w : gates_ | rv::keys) {
-        evaluate_wire(w);
+    if (!evaluated_) {
+        for (const reg r : undriven_) {
+            if (!overridden_[r]) {
+                throw input_error{"circuit has a wire with no signal"};
+            }
+        }
+        for (const auto& i : program_) {
+            if (!overridden_[i.output]) {
+                registers_[i.output] = gate_op(i.type, registers_[i.input1],
+                                               registers_[i.input2]);
+            }
+        }
+        evaluated_ = true;
+    }
+    else {
+        // Only the gates with an input which changed are recomputed, and
+        // their outputs count as changed only if their values did.
+        for (std::size_t pos{first_stale_}; pos < program_.size(); pos++) {
+            const auto& i{program_[pos]};
+            if (overridden_[i.output] ||
+                !(changed_[i.input1] || changed_[i.input2])) {
+                continue;
+            }
+            const signal s{gate_op(i.type, registers_[i.input1],
+                                   registers_[i.input2])};
+            if (s != registers_[i.output]) {
+                registers_[i.output] = s;
+                changed_[i.output] = true;
+            }
+        }
     }
+    std::fill(changed_.begin(), changed_.end(), false);
+    first_stale_ = program_.size();
 }
 
-void circuit::reset()
+std::vector<std::vector<signal>> circuit::evaluate_batch(
+    std::span<const wire_signals> overrides,
+    std::span<const wire> outputs) const
 {
-    computed_signals_.clear();
+    std::vector<reg> output_registers;
+    for (const auto& w : outputs) {
+        output_registers.push_back(registers_by_wire_.at(w));
+    }
+    std::vector<std::vector<signal>> result(overrides.size());
+    std::vector<planes> regs(registers_.size());
+    // Lanes in which each register is overridden.
+    std::vector<std::uint64_t> lane_mask(registers_.size());
+
+    for (std::size_t first{0}; first < overrides.size();
+         first += batch_lanes) {
+        const std::size_t lanes{
+            std::min(batch_lanes, overrides.size() - first)};
+        const std::uint64_t all_lanes{
+            lanes == batch_lanes ? ~std::uint64_t{0}
+                                 : (std::uint64_t{1} << lanes) - 1};
+
+        // Constants and wires set by `set_signal` hold the same value in
+        // every lane, other than where the batch overrides them.
+        std::ranges::transform(registers_, regs.begin(), broadcast);
+        std::ranges::fill(lane_mask, 0);
+        for (std::size_t lane{0}; lane < lanes; lane++) {
+            for (const auto& [w, s] : overrides[first + lane]) {
+                const reg r{registers_by_wire_.at(w)};
+                set_lane(regs[r], lane, s);
+                lane_mask[r] |= std::uint64_t{1} << lane;
+            }
+        }
+        for (const reg r : undriven_) {
+            if (!overridden_[r] && (lane_mask[r] & all_lanes) != all_lanes) {
+                throw input_error{"circuit has a wire with no signal"};
+            }
+        }
+
+        for (const auto& i : program_) {
+            if (overridden_[i.output]) {
+                continue;
+            }
+            const planes computed{
+                sliced_gate_op(i.type, regs[i.input1], regs[i.input2])};
+            const std::uint64_t m{lane_mask[i.output]};
+            auto& out{regs[i.output]};
+            for (std::size_t b{0}; b < out.size(); b++) {
+                out[b] = (computed[b] & ~m) | (out[b] & m);
+            }
+        }
+
+        for (std::size_t lane{0}; lane < lanes; lane++) {
+            auto& signals{result[first + lane]};
+            signals.reserve(output_registers.size());
+            for (const reg r : output_registers) {
+                signals.push_back(get_lane(regs[r], lane));
+            }
+        }
+    }
+    return result;
 }
 
-signal circuit::evaluate_input(const input& i)
+void circuit::reset()
 {
-    switch (i.index()) {
-        case 0:  // signal
-            return std::get<signal>(i);
-        case 1:  // wire
-            return evaluate_wire(std::get<wire>(i));
-    }
-    std::abort();  // Unreachable
+    std::fill(overridden_.begin(), overridden_.end(), false);
+    std::fill(changed_.begin(), changed_.end(), false);
+    first_stale_ = 0;
+    evaluated_ = false;
 }
 
-signal circuit::gate_op(gate_type type, signal i1, std::optional<signal> i2)
+signal circuit::gate_op(gate_type type, signal i1, signal i2) noexcept
 {
     switch (type) {
         case gate_type::assign:
             return i1;
         case gate_type::and_:
-            return i1 & *i2;
+            return i1 & i2;
         case gate_type::or_:
-            return i1 | *i2;
+            return i1 | i2;
         case gate_type::not_:
             return ~i1;
         case gate_type::lshift:
-            return static_cast<signal>(i1 << *i2);
+            return static_cast<signal>(i1 << i2);
         case gate_type::rshift:
-            return static_cast<signal>(i1 >> *i2);
+            return static_cast<signal>(i1 >> i2);
     }
     std::abort();  // Unreachable
 }
 
-signal circuit::evaluate_wire(const wire& w)
+void circuit::compile(const std::vector<gate_description>& gates)
 {
-    if (computed_signals_.count(w)) {
-        return computed_signals_.at(w);
+    // Give every wire and constant a register, with the constants' values
+    // filled in now since nothing writes to them.
+    std::vector<signal> constants;
+    std::vector<reg> constant_registers;
+    const auto register_for{[&](const input& i) {
+        if (const auto* s{std::get_if<signal>(&i)}) {
+            const auto r{static_cast<reg>(registers_by_wire_.size() +
+                                          constants.size())};
+            constants.push_back(*s);
+            constant_registers.push_back(r);
+            return r;
+        }
+        const auto& w{std::get<wire>(i)};
+        return registers_by_wire_
+            .try_emplace(w, static_cast<reg>(registers_by_wire_.size() +
+                                             constants.size()))
+            .first->second;
+    }};
+    std::vector<instruction> unordered;
+    unordered.reserve(gates.size());
+    for (const auto& g : gates) {
+        const reg input1{register_for(g.input1)};
+        const reg input2{g.input2 ? register_for(*g.input2) : input1};
+        unordered.push_back({g.type, input1, input2, register_for(g.output)});
     }
+    const std::size_t register_count{registers_by_wire_.size() +
+                                     constants.size()};
 
-    const auto& desc{gates_.at(w)};
-    signal i1_signal{evaluate_input(desc.input1)};
-    auto maybe_i2_signal{
-        desc.input2 ? std::optional<signal>{evaluate_input(*desc.input2)}
-                    : std::nullopt};
+    // Topological sort (Kahn's algorithm): a gate is ready once the gates
+    // driving its inputs have been placed.
+    constexpr std::size_t no_gate{static_cast<std::size_t>(-1)};
+    std::vector<std::size_t> driver(register_count, no_gate);
+    std::vector<std::vector<std::size_t>> readers(register_count);
+    for (std::size_t g{0}; g < unordered.size(); g++) {
+        auto& d{driver[unordered[g].output]};
+        if (d != no_gate) {
+            throw input_error{"circuit has a wire driven by two gates"};
+        }
+        d = g;
+        readers[unordered[g].input1].push_back(g);
+        readers[unordered[g].input2].push_back(g);
+    }
+    std::vector<int> pending_inputs(unordered.size(), 0);
+    std::vector<std::size_t> ready;
+    for (std::size_t g{0}; g < unordered.size(); g++) {
+        pending_inputs[g] = (driver[unordered[g].input1] != no_gate) +
+                            (driver[unordered[g].input2] != no_gate);
+        if (pending_inputs[g] == 0) {
+            ready.push_back(g);
+        }
+    }
+    program_.clear();
+    program_.reserve(unordered.size());
+    while (!ready.empty()) {
+        const auto g{ready.back()};
+        ready.pop_back();
+        program_.push_back(unordered[g]);
+        for (const auto reader : readers[unordered[g].output]) {
+            if (--pending_inputs[reader] == 0) {
+                ready.push_back(reader);
+            }
+        }
+    }
+    if (program_.size() != unordered.size()) {
+        throw input_error{"circuit has a loop"};
+    }
 
-    signal s{gate_op(desc.type, i1_signal, maybe_i2_signal)};
-    computed_signals_.emplace(w, s);
-    return s;
+    registers_.assign(register_count, 0);
+    for (std::size_t k{0}; k < constants.size(); k++) {
+        registers_[constant_registers[k]] = constants[k];
+    }
+    undriven_.clear();
+    for (const auto r : registers_by_wire_ | rv::values) {
+        if (driver[r] == no_gate) {
+            undriven_.push_back(r);
+        }
+    }
+    first_reader_.assign(register_count, program_.size());
+    for (std::size_t pos{program_.size()}; pos-- > 0;) {
+        first_reader_[program_[pos].input1] = pos;
+        first_reader_[program_[pos].input2] = pos;
+    }
+    overridden_.assign(register_count, false);
+    changed_.assign(register_count, false);
+    first_stale_ = 0;
+    evaluated_ = false;
 }
 
 circuit build_circuit(std::string_view in)
 {
     in = trim(in);
+    const auto gates{sv_lines(in) | rv::transform(gate_from_sv) |
+                     r::to<std::vector>()};
     circuit c;
-    for (const auto& desc : sv_lines(in) | rv::transform(gate_from_sv)) {
-        c.gates_.emplace(desc.output, desc);
-    }
+    c.compile(gates);
     return c;
 }
 
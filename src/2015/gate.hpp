@@ -9,17 +9,21 @@
 #define GATE_HPP
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
 #include <aoc_range.hpp>
 
 #include <fmt/format.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace aoc::year2015::gates {
 
@@ -40,6 +44,9 @@ gate_type gate_type_from_sv(std::string_view sv);
 
 std::string_view gate_type_to_sv(gate_type g) noexcept;
 
+// Signals to drive wires with, as if by `circuit::set_signal`.
+using wire_signals = std::vector<std::pair<wire, signal>>;
+
 struct gate_description {
     gate_type type;
     wire output;
@@ -51,22 +58,59 @@ struct gate_description {
 
 gate_description gate_from_sv(std::string_view sv);
 
+// A circuit is compiled when it is built: each wire and each constant input
+// gets a register, and the gates become a list of instructions in an order
+// where every gate comes after the gates driving its inputs.  Evaluating it
+// is then a single pass over the instructions.
 class circuit {
     friend circuit build_circuit(std::string_view);
 
    public:
-    void set_signal(wire w, signal s);
-    signal get_signal(wire w) const;
+    // Drive the wire with `s` instead of its gate, until `reset`.  If the
+    // circuit has already been evaluated, the next `evaluate` only
+    // recomputes the gates downstream of the wire.
+    void set_signal(const wire& w, signal s);
+    signal get_signal(const wire& w) const;
     void evaluate();
+    // Evaluate the circuit separately for each element of `overrides`, with
+    // its wires set as well as any set by `set_signal`, and return the
+    // signals on `outputs` for each: result[i][j] is `outputs[j]` for
+    // `overrides[i]`.  The evaluations are bit-sliced, 64 at a time, so
+    // this is much cheaper than calling `set_signal` and `evaluate` each
+    // time.  It does not change the circuit's own signals.
+    std::vector<std::vector<signal>> evaluate_batch(
+        std::span<const wire_signals> overrides,
+        std::span<const wire> outputs) const;
+    // Forget all signals, including those set by `set_signal`.
     void reset();
 
    private:
-    std::unordered_map<wire, gate_description> gates_;
-    std::unordered_map<wire, signal> computed_signals_;
-
-    signal evaluate_input(const input& i);
-    signal gate_op(gate_type type, signal i1, std::optional<signal> i2);
-    signal evaluate_wire(const wire& w);
+    using reg = std::uint32_t;
+
+    // Unary gates repeat their input as `input2`.
+    struct instruction {
+        gate_type type;
+        reg input1;
+        reg input2;
+        reg output;
+    };
+
+    aoc::flat_hash_map<wire, reg> registers_by_wire_;
+    std::vector<instruction> program_;
+    std::vector<signal> registers_;
+    // Wires which no gate drives, so they must be set by `set_signal`.
+    std::vector<reg> undriven_;
+    // Position in `program_` of the first instruction reading each register.
+    std::vector<std::size_t> first_reader_;
+    std::vector<std::uint8_t> overridden_;
+    // Registers set or changed since the last evaluation.
+    std::vector<std::uint8_t> changed_;
+    // Position in `program_` from which the next evaluation has to start.
+    std::size_t first_stale_{0};
+    bool evaluated_{false};
+
+    static signal gate_op(gate_type type, signal i1, signal i2) noexcept;
+    void compile(const std::vector<gate_description>& gates);
 };
 
 circuit build_circuit(std::string_view in);
@@ -0,0 +1,344 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "look_and_say.hpp"
+
+#include <aoc.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+
+namespace aoc::year2015::look_and_say {
+
+namespace {
+
+struct element {
+    std::string_view digits;
+    std::size_t decay_size;
+    std::array<std::uint8_t, 6> decay;
+};
+
+// Conway's 92 common elements, ordered by length, with the elements each
+// one becomes after one step.  "22" is the stable hydrogen, and "3" is
+// uranium.
+constexpr std::array<element, 92> elements{{
+    {"3", 1, {2}},
+    {"12", 1, {6}},
+    {"13", 1, {7}},
+    {"22", 1, {3}},
+    {"132", 1, {15}},
+    {"312", 1, {16}},
+    {"1112", 1, {8}},
+    {"1113", 1, {9}},
+    {"3112", 1, {17}},
+    {"3113", 1, {18}},
+    {"11131", 1, {19}},
+    {"11132", 1, {20}},
+    {"13211", 1, {29}},
+    {"31132", 1, {32}},
+    {"32112", 1, {31}},
+    {"111312", 1, {34}},
+    {"131112", 1, {30}},
+    {"132112", 1, {38}},
+    {"132113", 1, {39}},
+    {"311311", 1, {33}},
+    {"311312", 1, {43}},
+    {"311332", 3, {4, 1, 5}},
+    {"1112133", 2, {27, 0}},
+    {"1113222", 1, {21}},
+    {"1321132", 1, {52}},
+    {"1322112", 1, {40}},
+    {"1322113", 1, {41}},
+    {"3112112", 1, {42}},
+    {"3112221", 2, {4, 12}},
+    {"11131221", 1, {45}},
+    {"11133112", 2, {5, 14}},
+    {"13122112", 1, {51}},
+    {"13211312", 1, {57}},
+    {"13211321", 1, {58}},
+    {"31131112", 1, {44}},
+    {"123222112", 1, {49}},
+    {"123222113", 1, {50}},
+    {"311311222", 2, {24, 4}},
+    {"1113122112", 1, {54}},
+    {"1113122113", 1, {55}},
+    {"1113222112", 1, {46}},
+    {"1113222113", 1, {47}},
+    {"1321122112", 1, {60}},
+    {"1321131112", 1, {59}},
+    {"1321133112", 4, {10, 3, 1, 14}},
+    {"3113112211", 1, {53}},
+    {"3113322112", 2, {4, 35}},
+    {"3113322113", 2, {4, 36}},
+    {"13221133112", 3, {23, 1, 14}},
+    {"111213322112", 1, {61}},
+    {"111213322113", 1, {62}},
+    {"111311222112", 2, {13, 25}},
+    {"111312211312", 1, {65}},
+    {"132113212221", 1, {68}},
+    {"311311222112", 2, {24, 25}},
+    {"311311222113", 2, {24, 26}},
+    {"1322113312211", 3, {23, 1, 28}},
+    {"11131221131112", 1, {66}},
+    {"11131221131211", 1, {71}},
+    {"11131221133112", 3, {37, 1, 14}},
+    {"11131221222112", 1, {64}},
+    {"31121123222112", 1, {69}},
+    {"31121123222113", 1, {70}},
+    {"311322113212221", 1, {73}},
+    {"3113112211322112", 1, {72}},
+    {"3113112221131112", 2, {24, 48}},
+    {"3113112221133112", 5, {24, 2, 3, 1, 14}},
+    {"13221133122211332", 6, {23, 1, 9, 3, 1, 5}},
+    {"111312211312113211", 1, {79}},
+    {"132112211213322112", 1, {77}},
+    {"132112211213322113", 1, {78}},
+    {"311311222113111221", 2, {24, 56}},
+    {"13211321222113222112", 1, {80}},
+    {"13211322211312113211", 1, {83}},
+    {"132211331222113112211", 3, {23, 1, 63}},
+    {"12322211331222113112211", 4, {22, 3, 1, 63}},
+    {"31131122211311122113222", 2, {24, 67}},
+    {"111312212221121123222112", 1, {84}},
+    {"111312212221121123222113", 1, {85}},
+    {"311311222113111221131221", 2, {24, 74}},
+    {"11131221131211322113322112", 2, {76, 35}},
+    {"312211322212221121123222112", 1, {86}},
+    {"312211322212221121123222113", 1, {87}},
+    {"1113122113322113111221131221", 2, {37, 75}},
+    {"3113112211322112211213322112", 1, {88}},
+    {"3113112211322112211213322113", 1, {89}},
+    {"13112221133211322112211213322112", 5, {11, 2, 3, 1, 81}},
+    {"13112221133211322112211213322113", 5, {11, 2, 3, 1, 82}},
+    {"1321132122211322212221121123222112", 1, {90}},
+    {"1321132122211322212221121123222113", 1, {91}},
+    {"111312211312113221133211322112211213322112", 3, {76, 1, 81}},
+    {"111312211312113221133211322112211213322113", 3, {76, 1, 82}},
+}};
+
+// Terms are checked against their decomposition this many steps ahead, to be
+// sure the elements really decay independently.
+constexpr std::size_t verify_steps{12};
+
+// After this many steps, any start of digits 1 to 3 has become a string of
+// common elements.
+constexpr std::size_t max_prefix_steps{25};
+
+// Split `digits` into elements, trying longer elements first.  `dead_ends`
+// marks, by the number of digits left, suffixes already found not to split.
+bool parse(std::string_view digits, std::vector<std::uint8_t>& out,
+           std::vector<bool>& dead_ends)
+{
+    if (digits.empty()) {
+        return true;
+    }
+    if (dead_ends[digits.size()]) {
+        return false;
+    }
+    for (std::size_t e{elements.size()}; e-- > 0;) {
+        if (digits.starts_with(elements[e].digits)) {
+            out.push_back(static_cast<std::uint8_t>(e));
+            if (parse(digits.substr(elements[e].digits.size()), out,
+                      dead_ends)) {
+                return true;
+            }
+            out.pop_back();
+        }
+    }
+    dead_ends[digits.size()] = true;
+    return false;
+}
+
+std::string expand(const std::vector<std::uint8_t>& parts)
+{
+    std::string s;
+    for (const auto e : parts) {
+        s += elements[e].digits;
+    }
+    return s;
+}
+
+std::vector<std::uint8_t> decay(const std::vector<std::uint8_t>& parts)
+{
+    std::vector<std::uint8_t> next;
+    for (const auto e : parts) {
+        const auto products{std::span{elements[e].decay}.first(
+            elements[e].decay_size)};
+        next.insert(next.end(), products.begin(), products.end());
+    }
+    return next;
+}
+
+// The elements of `term`, if it splits into elements which then decay as
+// the term itself does.
+std::optional<std::vector<std::uint8_t>> decompose(const std::string& term)
+{
+    std::vector<std::uint8_t> parts;
+    std::vector<bool> dead_ends(term.size() + 1);
+    if (!parse(term, parts, dead_ends)) {
+        return std::nullopt;
+    }
+    auto expected{term};
+    auto next{parts};
+    for (std::size_t step{0}; step < verify_steps; step++) {
+        expected = say(expected);
+        next = decay(next);
+        if (expand(next) != expected) {
+            return std::nullopt;
+        }
+    }
+    return parts;
+}
+
+std::uint64_t checked_add(std::uint64_t a, std::uint64_t b)
+{
+    if (a > std::numeric_limits<std::uint64_t>::max() - b) {
+        throw solution_error("look-and-say length overflows");
+    }
+    return a + b;
+}
+
+}  // namespace
+
+std::string say(std::string_view digits)
+{
+    std::string out;
+    out.reserve(digits.size() * 2);
+    for (std::size_t i{0}; i < digits.size();) {
+        const char c{digits[i]};
+        std::size_t run{1};
+        while (i + run < digits.size() && digits[i + run] == c) {
+            run++;
+        }
+        fmt::format_to(std::back_inserter(out), "{}{}", run, c);
+        i += run;
+    }
+    return out;
+}
+
+sequence::sequence(std::string_view start)
+{
+    if (start.empty() || !std::ranges::all_of(start, is_digit)) {
+        throw input_error(fmt::format("Invalid look-and-say start {}", start));
+    }
+    std::string term{start};
+    for (std::size_t step{0}; step <= max_prefix_steps; step++) {
+        if (auto parts{decompose(term)}) {
+            prefix_.push_back(std::move(term));
+            elements_ = std::move(*parts);
+            return;
+        }
+        auto next{say(term)};
+        prefix_.push_back(std::move(term));
+        term = std::move(next);
+    }
+}
+
+std::uint64_t sequence::length_after(std::size_t steps) const
+{
+    if (steps < prefix_.size()) {
+        return prefix_[steps].size();
+    }
+    if (elements_.empty()) {
+        std::string term{prefix_.back()};
+        for (std::size_t step{prefix_.size() - 1}; step < steps; step++) {
+            term = say(term);
+        }
+        return term.size();
+    }
+
+    std::array<std::uint64_t, elements.size()> counts{};
+    for (const auto e : elements_) {
+        counts[e]++;
+    }
+    for (std::size_t step{prefix_.size() - 1}; step < steps; step++) {
+        std::array<std::uint64_t, elements.size()> next{};
+        for (std::size_t e{0}; e < elements.size(); e++) {
+            const auto& el{elements[e]};
+            for (std::size_t k{0}; k < el.decay_size; k++) {
+                next[el.decay[k]] = checked_add(next[el.decay[k]], counts[e]);
+            }
+        }
+        counts = next;
+    }
+    std::uint64_t length{0};
+    for (std::size_t e{0}; e < elements.size(); e++) {
+        const std::uint64_t size{elements[e].digits.size()};
+        if (counts[e] > std::numeric_limits<std::uint64_t>::max() / size) {
+            throw solution_error("look-and-say length overflows");
+        }
+        length = checked_add(length, counts[e] * size);
+    }
+    return length;
+}
+
+digit_stream sequence::digits_after(std::size_t steps) const
+{
+    digit_stream s;
+    if (steps < prefix_.size()) {
+        s.text_ = prefix_[steps];
+    }
+    else if (elements_.empty()) {
+        s.owned_text_ = prefix_.back();
+        for (std::size_t step{prefix_.size() - 1}; step < steps; step++) {
+            s.owned_text_ = say(s.owned_text_);
+        }
+        s.owns_text_ = true;
+    }
+    else {
+        s.elements_ = &elements_;
+        s.steps_ = steps - (prefix_.size() - 1);
+    }
+    return s;
+}
+
+std::optional<char> digit_stream::next()
+{
+    for (;;) {
+        const std::string_view text{owns_text_ ? std::string_view{owned_text_}
+                                               : text_};
+        if (pos_ < text.size()) {
+            return text[pos_++];
+        }
+        if (!elements_) {
+            return std::nullopt;
+        }
+
+        // Walk the tree of decays depth first until the next element which
+        // has no steps left to take, whose digits come next.
+        for (;;) {
+            if (stack_.empty()) {
+                if (next_element_ == elements_->size()) {
+                    return std::nullopt;
+                }
+                stack_.push_back({(*elements_)[next_element_++], steps_, 0});
+            }
+            auto& top{stack_.back()};
+            const auto& el{elements[top.element]};
+            if (top.steps == 0) {
+                text_ = el.digits;
+                pos_ = 0;
+                stack_.pop_back();
+                break;
+            }
+            if (top.next_product == el.decay_size) {
+                stack_.pop_back();
+                continue;
+            }
+            const frame child{el.decay[top.next_product++], top.steps - 1, 0};
+            stack_.push_back(child);
+        }
+    }
+}
+
+}  // namespace aoc::year2015::look_and_say
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef LOOK_AND_SAY_HPP
+#define LOOK_AND_SAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc::year2015::look_and_say {
+
+// One step of the sequence: "1211" becomes "111221".
+std::string say(std::string_view digits);
+
+class sequence;
+
+// The digits of one term of a sequence, produced one at a time without
+// building the whole term.  It refers to its sequence, which must outlive it.
+class digit_stream {
+   public:
+    std::optional<char> next();
+
+   private:
+    friend class sequence;
+
+    struct frame {
+        std::uint8_t element;
+        std::size_t steps;
+        std::size_t next_product;
+    };
+
+    // The digits being produced: a whole term which is not made of elements,
+    // or one element of a term which is.  A term computed just for this
+    // stream is kept in `owned_text_`.
+    std::string_view text_;
+    std::string owned_text_;
+    bool owns_text_{false};
+    std::size_t pos_{0};
+    const std::vector<std::uint8_t>* elements_{nullptr};
+    std::size_t next_element_{0};
+    std::size_t steps_{0};
+    std::vector<frame> stack_;
+};
+
+// A look-and-say sequence, tracked through Conway's "cosmological"
+// decomposition: after a few steps, a term is a string of the 92 common
+// elements, each of which decays into a fixed list of elements at each step.
+// Lengths then follow from counting elements, and digits are produced by
+// expanding each element recursively.
+class sequence {
+   public:
+    // Throws `input_error` unless `start` is a non-empty string of digits.
+    explicit sequence(std::string_view start);
+
+    std::uint64_t length_after(std::size_t steps) const;
+    digit_stream digits_after(std::size_t steps) const;
+
+   private:
+    // The first terms, up to the first which splits into common elements.
+    std::vector<std::string> prefix_;
+    // The elements of the last term of `prefix_`, or empty if it never split
+    // (as for starts containing digits above 3), in which case later terms
+    // are computed by `say`.
+    std::vector<std::uint8_t> elements_;
+};
+
+}  // namespace aoc::year2015::look_and_say
+
+#endif  // LOOK_AND_SAY_HPP
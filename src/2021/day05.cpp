@@ -6,12 +6,11 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
-#include <ctre.hpp>
-
 #include <cstdint>
 #include <map>
 #include <string_view>
@@ -31,22 +30,19 @@ struct vent_line {
     point b{};
 };
 
-vent_line parse_line(std::string_view line)
-{
-    constexpr auto vent_matcher{ctre::match<"(\\d+),(\\d+) -> (\\d+),(\\d+)">};
-    if (auto [whole, x1, y1, x2, y2] = vent_matcher(line); whole) {
-        return vent_line{vec_from_strings<scalar>(x1, y1),
-                         vec_from_strings<scalar>(x2, y2)};
-    }
-    throw input_error{fmt::format("failed to parse line: {}", line)};
-}
-
 std::vector<vent_line> parse_lines(std::string_view input)
 {
-    std::vector<vent_line> out;
-    out.reserve(500);
-    r::copy(sv_lines(input) | rv::transform(parse_line),
-            r::back_inserter(out));
+    // x1, y1, x2, y2
+    const auto columns{parse_columns<scalar, 4>(input)};
+    const auto x1{columns.column(0)};
+    const auto y1{columns.column(1)};
+    const auto x2{columns.column(2)};
+    const auto y2{columns.column(3)};
+
+    std::vector<vent_line> out(columns.rows());
+    for (std::size_t i{0}; i < out.size(); i++) {
+        out[i] = {{x1[i], y1[i]}, {x2[i], y2[i]}};
+    }
     return out;
 }
 
@@ -113,6 +109,15 @@ auto solve_hash(auto&& lines)
     return r::count_if(point_counts | rv::values, [](int i) { return i > 1; });
 }
 
+auto solve_flat_hash(auto&& lines)
+{
+    flat_hash_map<point, int> point_counts;
+    for (const auto p : all_line_points(lines)) {
+        point_counts[p]++;
+    }
+    return r::count_if(point_counts | rv::values, [](int i) { return i > 1; });
+}
+
 auto solve_sorted_points(auto&& lines)
 {
     std::vector<point> points;
@@ -163,6 +168,16 @@ aoc::solution_result day05hash(std::string_view input)
     return {count_a, count_b};
 }
 
+aoc::solution_result day05flat(std::string_view input)
+{
+    const std::vector<vent_line> all_vent_lines{parse_lines(input)};
+
+    const auto count_a{
+        solve_flat_hash(all_vent_lines | rv::filter(line_is_horiz_or_vert))};
+    const auto count_b{solve_flat_hash(all_vent_lines)};
+    return {count_a, count_b};
+}
+
 aoc::solution_result day05sortvec(std::string_view input)
 {
     const std::vector<vent_line> all_vent_lines{parse_lines(input)};
@@ -7,6 +7,7 @@
 
 #include <aoc.hpp>
 #include <aoc_grid.hpp>
+#include <aoc_packed_vec.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
@@ -23,20 +24,20 @@ namespace aoc::year2021 {
 namespace {
 
 using height_t = std::int8_t;
-using point_t = vec2<int>;
+using point_t = packed_vec2<>;
 using grid_t = dynamic_grid_adapter<std::vector<height_t>>;
 
-std::array<vec2<int>, 4> get_neighbors(vec2<int> p)
+std::array<point_t, 4> get_neighbors(point_t p)
 {
-    return {p + point_t{-1, 0}, p + point_t{1, 0}, p + point_t{0, -1},
-            p + point_t{0, 1}};
+    return p.orthogonal_neighbors();
 }
 
 std::set<point_t> get_low_points(const grid_t& grid)
 {
     std::set<point_t> low_points;
     const rect<int> area{{0, 0}, {grid.width(), grid.height()}};
-    for (auto p : area.all_points()) {
+    for (const auto v : area.all_points()) {
+        const point_t p{v};
         auto h{grid[p]};
         const auto neighbors{get_neighbors(p)};
         auto adjacents{neighbors | rv::filter([&](vec2<int> n) {
@@ -146,7 +147,8 @@ aoc::solution_result day09(std::string_view input)
     const rect<int> area{{0, 0}, {grid.width(), grid.height()}};
 
     std::map<point_t, std::set<point_t>> all_basins;
-    for (auto p : area.all_points()) {
+    for (const auto v : area.all_points()) {
+        const point_t p{v};
         height_t h{grid[p]};
         if (h >= 9) {
             continue;
@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_arena.hpp>
 #include <aoc_range.hpp>
 
 #include <fmt/format.h>
@@ -13,6 +14,7 @@
 #include <array>
 #include <cstdint>
 #include <map>
+#include <memory_resource>
 #include <string_view>
 #include <string>
 
@@ -33,7 +35,7 @@ struct rule_application {
                             const rule_application& rhs) = default;
 };
 
-using memos_t = std::map<rule_application, count_map_t>;
+using memos_t = std::pmr::map<rule_application, count_map_t>;
 
 count_map_t add_counts(const count_map_t& lhs, const count_map_t& rhs)
 {
@@ -96,7 +98,7 @@ count_map_t apply_rule(const rule_application& application,
 
 count_t solve(std::string_view polymer, const rules_t& rules, int iterations)
 {
-    memos_t memos;
+    memos_t memos{arena_resource()};
     count_map_t counts{count_occurrences(polymer)};
 
     for (const auto p : polymer | rv::sliding(2)) {
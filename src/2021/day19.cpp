@@ -6,16 +6,16 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_packed_vec.hpp>
+#include <aoc_parse.hpp>
 #include <aoc_range.hpp>
 
-#include <ctre.hpp>
-#include <fmt/format.h>
-
 #include <array>
 #include <optional>
 #include <set>
 #include <stdexcept>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace aoc::year2021 {
@@ -106,6 +106,20 @@ using position_t = vec3<scalar_t>;
 using matrix_t = matrix3<scalar_t>;
 using degrees_t = int;
 
+// Beacons are kept as packed keys, so the set lookups in the search for
+// overlapping scanners compare one word, and shifting a beacon is one add.
+using beacon_t = packed_vec3<>;
+
+beacon_t to_beacon(const position_t& p)
+{
+    return {p[0], p[1], p[2]};
+}
+
+position_t to_position(beacon_t b)
+{
+    return {b.x(), b.y(), b.z()};
+}
+
 constexpr position_t origin{{0, 0, 0}};
 
 constexpr matrix_t identity{{{
@@ -209,23 +223,20 @@ position_t parse_position(std::string_view line)
 
 int parse_scanner_id(std::string_view line)
 {
-    constexpr auto matcher{ctre::match<R"(--- scanner (\d+) ---)">};
-    if (auto [whole, id] = matcher(line); whole) {
-        return to_num<int>(id);
-    }
-    throw input_error{fmt::format("failed to parse input: {}", line)};
+    constexpr auto grammar{"--- scanner " + parse::integer<int> + " ---"};
+    return std::get<0>(parse::parse_line(grammar, line));
 }
 
 struct scanner_data {
     int scanner_id;
-    std::set<position_t> beacons;
+    std::set<beacon_t> beacons;
 };
 
 scanner_data parse_scanner_data(auto&& scanner_lines)
 {
     return {parse_scanner_id(scanner_lines.front()),
             scanner_lines | rv::drop(1) | rv::transform(parse_position) |
-                r::to<std::set>};
+                rv::transform(to_beacon) | r::to<std::set>};
 }
 
 // camera position/orientation/state
@@ -238,10 +249,10 @@ struct scanner_delta {
 scanner_data adjust_scanner_data(const scanner_data& data,
                                  const scanner_delta& delta)
 {
-    return {data.scanner_id, data.beacons |
+    return {data.scanner_id, data.beacons | rv::transform(to_position) |
                                  rv::transform(delta.orientation_delta) |
                                  rv::transform([&](const position_t& p) {
-                                     return p + delta.position_delta;
+                                     return to_beacon(p + delta.position_delta);
                                  }) |
                                  r::to<std::set>};
 }
@@ -250,29 +261,27 @@ std::optional<scanner_delta> compare_scanners(const scanner_data& a,
                                               const scanner_data& b)
 {
     for (const matrix_t& orientation : orientations) {
-        std::vector<position_t> b_rotated{
-            b.beacons | rv::transform(orientation) | r::to<std::vector>};
+        std::vector<beacon_t> b_rotated{
+            b.beacons | rv::transform(to_position) |
+            rv::transform(orientation) | rv::transform(to_beacon) |
+            r::to<std::vector>};
 
         // Assume this is the correct orientation.
         // Try aligning with each point in a.
 
-        for (const position_t& a_position : a.beacons) {
-            for (const position_t& b_position : b_rotated) {
-                position_t delta{a_position - b_position};
-
-                std::vector<position_t> b_shifted{
-                    b_rotated | rv::transform([delta](const position_t& p) {
-                        return p + delta;
-                    }) |
-                    r::to<std::vector>};
+        for (const beacon_t a_position : a.beacons) {
+            for (const beacon_t b_position : b_rotated) {
+                const beacon_t::offset delta{a_position - b_position};
 
                 std::size_t count{0};
-                for (const position_t& b_pos : b_shifted) {
-                    count += a.beacons.count(b_pos);
+                for (const beacon_t b_pos : b_rotated) {
+                    count += a.beacons.count(b_pos + delta);
                 }
 
                 if (count >= 12) {
-                    return scanner_delta{orientation, delta};
+                    return scanner_delta{orientation,
+                                         to_position(a_position) -
+                                             to_position(b_position)};
                 }
             }
         }
@@ -319,7 +328,7 @@ aoc::solution_result day19(std::string_view input)
         }
     }
 
-    std::set<position_t> beacons_relative_to_zero;
+    std::set<beacon_t> beacons_relative_to_zero;
     for (const auto& [id, group] : scanner_data_adjusted_to_zero) {
         beacons_relative_to_zero.insert(group.beacons.begin(),
                                         group.beacons.end());
@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_arena.hpp>
 #include <aoc_range.hpp>
 
 #include <ctre.hpp>
@@ -13,6 +14,7 @@
 #include <array>
 #include <cstdint>
 #include <map>
+#include <memory_resource>
 #include <string_view>
 #include <vector>
 
@@ -146,20 +148,20 @@ constexpr std::array<three_roll_frequency, 7> three_roll_frequencies{{
     {9, 1},
 }};
 
-using count_map_t = std::map<game_state_b, universe_count_t>;
+using count_map_t = std::pmr::map<game_state_b, universe_count_t>;
 
 universe_count_t solve_part2(game_state_b starting_state)
 {
     universe_count_t won_count{0};
 
-    count_map_t last_turn_states;
+    count_map_t last_turn_states{arena_resource()};
     last_turn_states[starting_state] = 1;
 
     auto is_done = [](const auto& pair) { return pair.first.is_done(); };
     auto is_won = [](const auto& pair) { return pair.first.is_won(); };
 
     for (int turn{1}; turn <= 22; turn++) {
-        count_map_t turn_states;
+        count_map_t turn_states{arena_resource()};
         // For each turn state, construct seven new turn states for the 7
         // possible 3-roll outcomes, with the appropriate counts
         for (const auto& [state, count] : last_turn_states) {
@@ -15,6 +15,7 @@ aoc::solution_result day03(std::string_view);
 aoc::solution_result day04(std::string_view);
 aoc::solution_result day05map(std::string_view);
 aoc::solution_result day05hash(std::string_view);
+aoc::solution_result day05flat(std::string_view);
 aoc::solution_result day05sortvec(std::string_view);
 aoc::solution_result day05grid(std::string_view);
 aoc::solution_result day06(std::string_view);
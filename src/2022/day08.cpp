@@ -9,6 +9,9 @@
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <string_view>
 
 namespace aoc::year2022 {
@@ -21,47 +24,50 @@ aoc::solution_result day08(std::string_view input)
     dynamic_grid<char> grid{grid_width, grid_height};
     r::copy(lines | rv::join, grid.data().begin());
 
+    // North/south lines of sight are scanned along the rows of a transposed
+    // copy so that every scan runs over contiguous memory.
+    const auto columns{transposed(grid)};
+
     const auto visible{[&](auto p) {
         const auto tree_height{grid[p]};
-        const auto row{grid.row(p.y)};
-        const auto col{grid.col(p.x)};
+        const auto row{row_span(grid, p.y)};
+        const auto col{row_span(columns, p.x)};
+        const auto x{static_cast<std::size_t>(p.x)};
+        const auto y{static_cast<std::size_t>(p.y)};
         const auto shorter{[&](auto t) { return t < tree_height; }};
-        const auto west_approach{row | rv::take(p.x)};
-        const auto east_approach{row | rv::reverse |
-                                 rv::take(grid_width - p.x - 1)};
-        const auto north_approach{col | rv::take(p.y)};
-        const auto south_approach{col | rv::reverse |
-                                  rv::take(grid_height - p.y - 1)};
-        return r::all_of(west_approach, shorter) ||
-               r::all_of(east_approach, shorter) ||
-               r::all_of(north_approach, shorter) ||
-               r::all_of(south_approach, shorter);
+        return r::all_of(row.first(x), shorter) ||
+               r::all_of(row.subspan(x + 1), shorter) ||
+               r::all_of(col.first(y), shorter) ||
+               r::all_of(col.subspan(y + 1), shorter);
     }};
     const auto visible_count{r::count_if(grid.area().all_points(), visible)};
 
     const auto scenic_score{[&](auto p) {
         const auto tree_height{grid[p]};
-        const auto row{grid.row(p.y)};
-        const auto col{grid.col(p.x)};
-        const auto shorter{[&](auto t) { return t < tree_height; }};
-
-        const auto west{row | rv::take(p.x) | rv::reverse};
-        const auto east{row | rv::drop(p.x + 1)};
-        const auto north{col | rv::take(p.y) | rv::reverse};
-        const auto south{col | rv::drop(p.y + 1)};
+        const auto row{row_span(grid, p.y)};
+        const auto col{row_span(columns, p.x)};
+        const auto x{static_cast<std::size_t>(p.x)};
+        const auto y{static_cast<std::size_t>(p.y)};
+        const auto blocking{[&](auto t) { return t >= tree_height; }};
 
-        const auto west_shorter{west | rv::take_while(shorter)};
-        const auto east_shorter{east | rv::take_while(shorter)};
-        const auto north_shorter{north | rv::take_while(shorter)};
-        const auto south_shorter{south | rv::take_while(shorter)};
+        // Number of trees seen looking from `first` to `last` (nearest tree
+        // first): all of them up to and including the first one at least as
+        // tall.
+        const auto viewing_distance{[&](auto first, auto last) {
+            const auto blocker{std::find_if(first, last, blocking)};
+            const auto seen{std::distance(first, blocker)};
+            return blocker == last ? seen : seen + 1;
+        }};
 
-        const auto west_view{west | rv::take(r::distance(west_shorter) + 1)};
-        const auto east_view{east | rv::take(r::distance(east_shorter) + 1)};
-        const auto north_view{north | rv::take(r::distance(north_shorter) + 1)};
-        const auto south_view{south | rv::take(r::distance(south_shorter) + 1)};
+        const auto west{row.first(x)};
+        const auto east{row.subspan(x + 1)};
+        const auto north{col.first(y)};
+        const auto south{col.subspan(y + 1)};
 
-        return r::distance(west_view) * r::distance(east_view) *
-               r::distance(south_view) * r::distance(north_view);
+        return viewing_distance(west.rbegin(), west.rend()) *
+               viewing_distance(east.begin(), east.end()) *
+               viewing_distance(north.rbegin(), north.rend()) *
+               viewing_distance(south.begin(), south.end());
     }};
     const auto highest_scenic_score{
         r::max(grid.area().all_points() | rv::transform(scenic_score))};
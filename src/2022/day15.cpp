@@ -6,15 +6,14 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_interval.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
-#include <ctre.hpp>
-
-#include <array>
 #include <cstdint>
-#include <optional>
+#include <cstdlib>
 #include <set>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -24,142 +23,102 @@ namespace {
 
 using int_t = int;
 using pos_t = vec2<int_t>;
-using rect_t = rect<int_t>;
-using range_t = std::pair<int_t, int_t>;  // Bounds of a range, both inclusive
+using interval_t = interval<int_t>;
 
-struct pair_t {
-    pos_t sensor;
-    pos_t beacon;
+// Each sensor's position and its distance to its closest beacon, as columns.
+struct sensor_columns {
+    std::span<const int_t> x;
+    std::span<const int_t> y;
+    std::span<const int_t> radius;
 };
 
-pair_t parse_line(std::string_view line)
+std::vector<int_t> manhattan_distances(std::span<const int_t> x1,
+                                       std::span<const int_t> y1,
+                                       std::span<const int_t> x2,
+                                       std::span<const int_t> y2)
 {
-    constexpr auto matcher{ctre::match<
-        R"(Sensor at x=(.+), y=(.+): closest beacon is at x=(.+), y=(.+))">};
-    if (auto [whole, x1, y1, x2, y2] = matcher(line); whole) {
-        return {{to_num<int_t>(x1), to_num<int_t>(y1)},
-                {to_num<int_t>(x2), to_num<int_t>(y2)}};
+    std::vector<int_t> out(x1.size());
+    for (std::size_t i{0}; i < out.size(); i++) {
+        out[i] = std::abs(x1[i] - x2[i]) + std::abs(y1[i] - y2[i]);
     }
-    throw input_error{fmt::format("failed to parse input: {}", line)};
-}
-
-int_t manhattan(const pair_t& p)
-{
-    const auto delta{p.sensor - p.beacon};
-    return std::abs(delta.x) + std::abs(delta.y);
+    return out;
 }
 
-bool within_diamond(const pair_t& pair, const pos_t pos)
+// Positions in `row` within range of any sensor.  `ranges` is scratch space,
+// passed in so that it and `covered` can be reused from row to row without
+// allocating.
+void cover_row(const sensor_columns& sensors,
+               int_t row,
+               std::vector<interval_t>& ranges,
+               interval_set<int_t>& covered)
 {
-    const auto& [sensor, beacon]{pair};
-    return manhattan({sensor, pos}) <= manhattan(pair);
-}
-
-rect_t find_area(const std::vector<pair_t>& pairs)
-{
-    const auto greatest_manhattan{r::max(pairs | rv::transform(manhattan))};
-    const auto positions{pairs | rv::transform([](const pair_t& p) {
-                             return std::array<pos_t, 2>{p.sensor, p.beacon};
-                         }) |
-                         rv::join | r::to<std::vector>};
-    pos_t top_left{r::front(positions)};
-    pos_t bottom_right{r::front(positions)};
-    for (const auto& p : positions) {
-        top_left.x = r::min(top_left.x, p.x);
-        top_left.y = r::min(top_left.y, p.y);
-        bottom_right.x = r::max(bottom_right.x, p.x);
-        bottom_right.y = r::max(bottom_right.y, p.y);
+    ranges.clear();
+    for (std::size_t i{0}; i < sensors.x.size(); i++) {
+        const int_t y_delta{std::abs(sensors.y[i] - row)};
+        const int_t half_range{sensors.radius[i] - y_delta};
+        if (half_range >= 0) {
+            ranges.push_back(
+                {sensors.x[i] - half_range, sensors.x[i] + half_range + 1});
+        }
     }
-    top_left -= {greatest_manhattan, greatest_manhattan};
-    bottom_right += {greatest_manhattan, greatest_manhattan};
-    return rect_from_corners(top_left, bottom_right);
+    covered.assign(ranges);
 }
 
-std::optional<range_t> get_horizontal_range(const pair_t& pair, int_t row)
-{
-    const auto this_manhattan{manhattan(pair)};
-    const auto& [sensor, beacon]{pair};
-    const auto [x, y]{sensor};
-    const int_t y_delta{std::abs(y - row)};
-    const int_t half_range{this_manhattan - y_delta};
-    if (half_range < 0) {
-        return std::nullopt;
-    }
-    return range_t{x - half_range, x + half_range};
-}
+}  // namespace
 
-range_t combine_overlapping_ranges(const range_t& lhs, const range_t& rhs)
+aoc::solution_result day15(std::string_view input)
 {
-    if (rhs.first <= lhs.second + 1) {
-        return range_t{lhs.first, std::max(lhs.second, rhs.second)};
+    // Sensor x, sensor y, beacon x, beacon y
+    const auto columns{parse_columns<int_t, 4>(trim(input))};
+    const auto sensor_x{columns.column(0)};
+    const auto sensor_y{columns.column(1)};
+    const auto beacon_x{columns.column(2)};
+    const auto beacon_y{columns.column(3)};
+    const auto radius{
+        manhattan_distances(sensor_x, sensor_y, beacon_x, beacon_y)};
+    const sensor_columns sensors{sensor_x, sensor_y, radius};
+
+    std::set<pos_t> beacon_set;
+    for (std::size_t i{0}; i < columns.rows(); i++) {
+        beacon_set.insert({beacon_x[i], beacon_y[i]});
     }
-    return lhs;
-}
-
-range_t combine_many_overlapping_ranges(const std::vector<range_t>& ranges)
-{
-    return r::accumulate(ranges, ranges[0], combine_overlapping_ranges);
-};
 
-}  // namespace
+    // The width of the area any sensor can reach.
+    const int_t greatest_radius{r::max(radius)};
+    const int_t min_x{std::min(r::min(sensor_x), r::min(beacon_x))};
+    const int_t max_x{std::max(r::max(sensor_x), r::max(beacon_x))};
+    const int_t area_width{max_x - min_x + 2 * greatest_radius + 1};
 
-aoc::solution_result day15(std::string_view input)
-{
-    const auto pairs{sv_lines(trim(input)) | rv::transform(parse_line) |
-                     r::to<std::vector>};
-    const auto beacon_set{
-        pairs | rv::transform([](const pair_t p) { return p.beacon; }) |
-        r::to<std::set>};
-    const auto area{find_area(pairs)};
-
-    const auto cannot_contain_beacon{[&](pos_t p) {
-        const auto p_within_diamond{
-            [p](const pair_t& pair) { return within_diamond(pair, p); }};
-        return !beacon_set.contains(p) && r::any_of(pairs, p_within_diamond);
-    }};
-
-    const bool is_example_input{area.dimensions.x < 1000};
+    const bool is_example_input{area_width < 1000};
     const int_t part1_y{is_example_input ? 10 : 2000000};
 
-    const auto row_positions{rv::iota(area.base.x) |
-                             rv::take(area.dimensions.x) |
-                             rv::transform([part1_y](int_t x) {
-                                 return pos_t{x, part1_y};
-                             })};
+    std::vector<interval_t> ranges;
+    interval_set<int_t> covered;
 
-    const auto part1_count{r::count_if(row_positions, cannot_contain_beacon)};
+    cover_row(sensors, part1_y, ranges, covered);
+    const auto beacons_covered{
+        r::count_if(beacon_set, [&](const pos_t beacon) {
+            return beacon.y == part1_y && covered.contains(beacon.x);
+        })};
+    const auto part1_count{covered.length() - beacons_covered};
 
     const int_t part2_max{is_example_input ? 20 : 4000000};
 
-    const auto get_ranges{[&](const int_t y) -> const std::vector<range_t>& {
-        const auto y_horizontal_range{
-            [y](const pair_t& p) { return get_horizontal_range(p, y); }};
-        static std::vector<range_t> ranges;
-        ranges.clear();
-        r::copy(
-            pairs | rv::transform(y_horizontal_range) |
-                rv::filter([](const auto& opt) { return opt.has_value(); }) |
-                rv::transform([](const auto& opt) { return *opt; }),
-            std::back_inserter(ranges));
-        // TODO: Combined filter/transform view for std::optional
-        r::sort(ranges);
-        return ranges;
-    }};
-    const auto get_first_x_not_in_ranges{[&](const int_t y) {
-        const auto range{combine_many_overlapping_ranges(get_ranges(y))};
-        return range.second + 1;
-    }};
-
-    const auto search_rows{rv::iota(0) | rv::take(part2_max + 1)};
-    const auto in_search_area{[=](auto yx_pair) {
-        return static_cast<int_t>(yx_pair.second) <= part2_max;
-    }};
-    const auto [part2_y, part2_x]{
-        (search_rows | rv::transform(get_first_x_not_in_ranges) |
-         rv::enumerate | rv::filter(in_search_area) | r::to<std::vector>)
-            .front()};
-    const auto tuning_frequency{part2_x * 4000000LL +
-                                static_cast<std::int64_t>(part2_y)};
+    pos_t distress_beacon{-1, -1};
+    for (int_t y{0}; y <= part2_max; y++) {
+        cover_row(sensors, y, ranges, covered);
+        const auto from_zero{covered.find(0)};
+        const int_t x{from_zero == covered.end() ? 0 : from_zero->hi};
+        if (x <= part2_max) {
+            distress_beacon = {x, y};
+            break;
+        }
+    }
+    if (distress_beacon.y < 0) {
+        throw solution_error("no position found for the distress beacon");
+    }
+    const auto tuning_frequency{distress_beacon.x * 4000000LL +
+                                static_cast<std::int64_t>(distress_beacon.y)};
 
     return {part1_count, tuning_frequency};
 }
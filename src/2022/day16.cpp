@@ -6,8 +6,10 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_generator.hpp>
 #include <aoc_graph.hpp>
 #include <aoc_range.hpp>
+#include <small_vector.hpp>
 
 #include <ctre.hpp>
 
@@ -51,7 +53,7 @@ valve_set_t set_with(valve_set_t set, valve_t valve)
 //     set |= ~(valve_t{1} << valve);
 // }
 
-Generator<valve_t> set_range(valve_set_t set)
+generator<valve_t> set_range(valve_set_t set)
 {
     for (valve_t v{0}; v < 64; v++) {
         if (set_contains(set, v)) {
@@ -245,8 +247,7 @@ aoc::solution_result day16(std::string_view input)
             valve_set_t to_open{network.flow_valves ^ state.opened};
             const flow_t current_flow_per_minute{
                 count_flow(network, state.opened)};
-            // TODO not new vector
-            std::vector<state_t> out{};
+            small_vector<state_t, 16> out{};
             for (valve_t v : set_range(to_open)) {
                 if (v == state.location) {
                     // Don't "move to self" unless we're waiting
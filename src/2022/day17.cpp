@@ -6,13 +6,20 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_cycle.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
 #include <fmt/ranges.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace aoc::year2022 {
 
@@ -159,27 +166,79 @@ pos_t jet_move(char c)
     throw input_error(fmt::format("Invalid character: '{}'", c));
 }
 
-std::vector<std::int64_t> drop_blocks(grid_t& grid,
-                                      std::size_t block_count,
-                                      const std::vector<pos_t>& jet_patterns)
+// Number of columns a piece can fall down, between the walls.
+constexpr int room_width{7};
+
+// Rows of the cells which falling pieces can still reach, from the top of the
+// tower down, each as a mask of the room's columns and ending with an empty
+// mask.  Pieces only move left, right and down, so every cell of a piece gets
+// where it is by such moves through empty cells, starting from the empty row
+// above the tower.  Cells which can't be reached that way never affect where
+// later pieces land, so these rows are the whole of the tower's state.
+void find_reachable(grid_t& grid, int top, std::vector<std::uint8_t>& rows)
 {
-    const auto jet_cycle(jet_patterns | rv::cycle);
-    auto jet_iter{jet_cycle.begin()};
+    constexpr unsigned all_columns{(1U << room_width) - 1};
+    rows.clear();
+    unsigned reached{all_columns};
+    for (int y{top}; reached != 0; y++) {
+        const auto cells{row_span(grid, y)};
+        unsigned empty{0};
+        for (int x{0}; x < room_width; x++) {
+            if (cells[static_cast<std::size_t>(x + 1)] == '.') {
+                empty |= 1U << x;
+            }
+        }
+        reached &= empty;
+        for (unsigned before{0}; before != reached;) {
+            before = reached;
+            reached |= (reached << 1 | reached >> 1) & empty;
+        }
+        rows.push_back(static_cast<std::uint8_t>(reached));
+    }
+}
+
+struct drop_result {
+    // Height of the tower after each number of blocks, starting with zero.
+    std::vector<std::int64_t> tower_height;
+    // Cycle in the state of the top of the tower, if one was found.
+    std::optional<cycle> tower_cycle;
+};
 
-    const auto piece_cycle(pieces | rv::cycle);
-    auto piece_iter{piece_cycle.begin()};
+// Drop up to `block_count` blocks, stopping early once the state before a drop
+// (next piece, next jet and the cells pieces can reach, relative to the top of
+// the tower) repeats.
+drop_result drop_blocks(grid_t& grid,
+                        std::size_t block_count,
+                        const std::vector<pos_t>& jet_patterns)
+{
+    std::size_t jet_index{0};
+    std::size_t piece_index{0};
 
     auto highest_rock_row{grid.height() - 1};
-    std::vector<std::int64_t> tower_height_by_block;
-    tower_height_by_block.reserve(static_cast<std::size_t>(grid.height()));
+    drop_result out;
+    out.tower_height.reserve(block_count + 1);
+    out.tower_height.push_back(0);
+
+    std::vector<std::uint8_t> reachable;
+    cycle_detector<> detector;
 
     for (std::size_t r{0}; r < block_count; r++) {
-        auto piece{*piece_iter++};
+        find_reachable(grid, highest_rock_row, reachable);
+        out.tower_cycle = detector.record(
+            hash_span(std::span{reachable},
+                      piece_index * jet_patterns.size() + jet_index));
+        if (out.tower_cycle) {
+            break;
+        }
+
+        const auto& piece{pieces[piece_index]};
+        piece_index = (piece_index + 1) % pieces.size();
         pos_t pos{3, highest_rock_row - piece.height() - 3};
         // print_piece_in_room(grid, piece, pos);
         bool placed{false};
         while (!placed) {
-            auto move{*jet_iter++};
+            auto move{jet_patterns[jet_index]};
+            jet_index = (jet_index + 1) % jet_patterns.size();
             if (!check_collision(grid, piece, pos + move)) {
                 pos += move;
             }
@@ -197,10 +256,30 @@ std::vector<std::int64_t> drop_blocks(grid_t& grid,
         }
         highest_rock_row =
             std::min(highest_rock_row, pos.y + (4 - piece_height(piece)));
-        tower_height_by_block.push_back(grid.height() - highest_rock_row - 1);
+        out.tower_height.push_back(grid.height() - highest_rock_row - 1);
     }
 
-    return tower_height_by_block;
+    return out;
+}
+
+// Height of the tower after `block_count` blocks, extrapolating through the
+// cycle if the simulation stopped before reaching that many blocks.
+std::int64_t tower_height_after(const drop_result& result,
+                                std::size_t block_count)
+{
+    if (block_count < result.tower_height.size()) {
+        return result.tower_height[block_count];
+    }
+    if (!result.tower_cycle) {
+        throw solution_error{"no cycle found in tower"};
+    }
+    const cycle& c{*result.tower_cycle};
+    const auto cycle_growth{result.tower_height[c.offset + c.period] -
+                            result.tower_height[c.offset]};
+    const auto full_cycles{
+        static_cast<std::int64_t>((block_count - c.offset) / c.period)};
+    return result.tower_height[c.equivalent_step(block_count)] +
+           full_cycles * cycle_growth;
 }
 
 }  // namespace
@@ -210,41 +289,16 @@ aoc::solution_result day17(std::string_view input)
     const auto jet_patterns(trim(input) | rv::transform(jet_move) |
                             r::to<std::vector>);
 
-    auto grid1{initialize_room()};
+    // The tower repeats within a few thousand blocks for real inputs; this is
+    // just a bound on how much of the room can be filled.
+    const std::size_t max_blocks_to_drop{200000};
+    auto grid{initialize_room()};
     // print_grid(grid);
-    std::vector<std::int64_t> tower_height1{
-        drop_blocks(grid1, rock_count1, jet_patterns)};
+    const auto result{drop_blocks(grid, max_blocks_to_drop, jet_patterns)};
     // print_grid(grid, 3000);
 
-    auto grid2{initialize_room()};
-    const std::size_t rocks_to_actually_drop2{200000};
-    std::vector<std::int64_t> tower_height2{
-        drop_blocks(grid2, rocks_to_actually_drop2, jet_patterns)};
-
-    // detect cycle period
-    std::vector<std::int64_t> differences;
-    differences.resize(tower_height2.size());
-    r::adjacent_difference(tower_height2, differences.begin());
-    r::reverse(differences);
-    const auto section{differences | rv::take(20) | r::to<std::vector>};
-    auto search_result{r::search(differences | rv::drop(1), section)};
-
-    const auto cycle_period{static_cast<std::size_t>(
-        r::distance(differences.begin(), search_result.begin()))};
-
-    const auto tower_height_reversed{tower_height2 | rv::reverse |
-                                     r::to<std::vector>};
-    const std::size_t cycle_height_diff{static_cast<std::size_t>(
-        tower_height_reversed[0] - tower_height_reversed[cycle_period])};
-    const std::size_t rocks_after_drop{rock_count2 - rocks_to_actually_drop2};
-    const std::size_t cycles_to_multiply{rocks_after_drop / cycle_period + 1};
-    const auto rocks_calculated{cycles_to_multiply * cycle_period};
-    const auto final_tower_height2{
-        cycles_to_multiply * cycle_height_diff +
-        static_cast<std::size_t>(
-            tower_height_reversed[rocks_calculated - rocks_after_drop])};
-
-    return {tower_height1.back(), final_tower_height2};
+    return {tower_height_after(result, rock_count1),
+            tower_height_after(result, rock_count2)};
 }
 
 }  // namespace aoc::year2022
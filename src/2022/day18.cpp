@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_packed_vec.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
 
@@ -20,7 +21,7 @@ namespace aoc::year2022 {
 namespace {
 
 using int_t = int;
-using coord_t = vec3<int_t>;
+using coord_t = packed_vec3<>;
 const coord_t origin{0, 0, 0};
 
 coord_t parse_line(std::string_view line)
@@ -29,24 +30,24 @@ coord_t parse_line(std::string_view line)
     return {nums[0], nums[1], nums[2]};
 }
 
-std::array<coord_t, 6> directions{coord_t{-1, 0, 0}, coord_t{1, 0, 0},
-                                  coord_t{0, -1, 0}, coord_t{0, 1, 0},
-                                  coord_t{0, 0, -1}, coord_t{0, 0, 1}};
+const std::array<coord_t::offset, 6> directions{coord_t::face_offsets()};
 
 auto neighbors(const coord_t& c)
 {
-    return directions | rv::transform([c](const coord_t d) { return c + d; });
+    return directions |
+           rv::transform([c](const coord_t::offset d) { return c + d; });
 }
 
 coord_t max(const coord_t& a, const coord_t& b)
 {
-    return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+    return {std::max(a.x(), b.x()), std::max(a.y(), b.y()),
+            std::max(a.z(), b.z())};
 }
 
 bool in_cuboid(const coord_t& c, const coord_t& dim)
 {
-    return c.x >= 0 && c.y >= 0 && c.z >= 0 && c.x < dim.x && c.y < dim.y &&
-           c.z < dim.z;
+    return c.x() >= 0 && c.y() >= 0 && c.z() >= 0 && c.x() < dim.x() &&
+           c.y() < dim.y() && c.z() < dim.z();
 }
 
 std::set<coord_t> bfs_water_cubes_from_origin(const coord_t& dimensions,
@@ -100,13 +101,13 @@ aoc::solution_result day18(std::string_view input)
 
     // identify enclosing cuboid
     const coord_t dimensions{r::accumulate(cubes, origin, max) +
-                             coord_t{2, 2, 2}};
+                             coord_t::offset{2, 2, 2}};
 
     const auto water{bfs_water_cubes_from_origin(dimensions, cubes)};
     std::set<coord_t> droplet_and_interior{cubes};
-    for (int x : rv::iota(0, dimensions.x)) {
-        for (int y : rv::iota(0, dimensions.y)) {
-            for (int z : rv::iota(0, dimensions.z)) {
+    for (int x : rv::iota(0, dimensions.x())) {
+        for (int y : rv::iota(0, dimensions.y())) {
+            for (int z : rv::iota(0, dimensions.z())) {
                 coord_t c{x, y, z};
                 if (!water.contains(c)) {
                     droplet_and_interior.insert(c);
@@ -8,6 +8,7 @@
 #include <aoc.hpp>
 #include <aoc_graph.hpp>
 #include <aoc_range.hpp>
+#include <small_vector.hpp>
 
 #include <fmt/ranges.h>
 
@@ -134,7 +135,7 @@ auto adj_func_for_blueprint(const blueprint_t& blueprint,
     }
 
     const auto adj_func{[=](const state_t& state) {
-        std::vector<state_t> out;
+        small_vector<state_t, 4> out;
         if (state.minute == minute_deadline) {
             return out;
         }
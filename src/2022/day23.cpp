@@ -6,34 +6,36 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
+#include <aoc_packed_vec.hpp>
 #include <aoc_range.hpp>
 #include <aoc_vec.hpp>
+#include <small_vector.hpp>
 
 #include <fmt/ranges.h>
 
-#include <map>
-#include <set>
 #include <string_view>
 
 namespace aoc::year2022 {
 
 namespace {
 
-using pos_t = vec2<int>;
+using pos_t = packed_vec2<>;
+using offset_t = pos_t::offset;
 using rect_t = rect<int>;
 
-rect_t find_bounds(const std::set<pos_t>& elves)
+rect_t find_bounds(const flat_hash_set<pos_t>& elves)
 {
-    pos_t min{*elves.begin()};
-    pos_t max{min};
+    auto min{static_cast<vec2<int>>(*elves.begin())};
+    auto max{min};
     for (const auto& elf : elves) {
-        min = {std::min(min.x, elf.x), std::min(min.y, elf.y)};
-        max = {std::max(max.x, elf.x), std::max(max.y, elf.y)};
+        min = {std::min(min.x, elf.x()), std::min(min.y, elf.y())};
+        max = {std::max(max.x, elf.x()), std::max(max.y, elf.y())};
     }
     return rect_from_corners(min, max);
 }
 
-// void print_elves(const std::set<pos_t>& elves, int round)
+// void print_elves(const flat_hash_set<pos_t>& elves, int round)
 // {
 //     fmt::print("== {} ==\n", round);
 //     const auto bounds{find_bounds(elves)};
@@ -49,21 +51,20 @@ rect_t find_bounds(const std::set<pos_t>& elves)
 //     fmt::print("\n");
 // }
 
-const std::array<std::pair<pos_t, std::array<pos_t, 3>>, 4> dirs{{
+const std::array<std::pair<offset_t, std::array<offset_t, 3>>, 4> dirs{{
     {{0, -1}, {{{-1, -1}, {0, -1}, {1, -1}}}},
     {{0, 1}, {{{-1, 1}, {0, 1}, {1, 1}}}},
     {{-1, 0}, {{{-1, -1}, {-1, 0}, {-1, 1}}}},
     {{1, 0}, {{{1, -1}, {1, 0}, {1, 1}}}},
 }};
 
-const std::array<pos_t, 8> neighbors{
-    {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}};
+const std::array<offset_t, 8> neighbors{pos_t::all_offsets()};
 
 }  // namespace
 
 aoc::solution_result day23(std::string_view input)
 {
-    std::set<pos_t> elves;
+    flat_hash_set<pos_t> elves;
     const auto lines{sv_lines(trim(input)) | r::to<std::vector>};
     const int width{static_cast<int>(lines[0].size())};
     const int height{static_cast<int>(lines.size())};
@@ -80,11 +81,12 @@ aoc::solution_result day23(std::string_view input)
 
     const auto propose{[&](pos_t elf) {
         if (r::none_of(neighbors,
-                       [&](pos_t n) { return elves.contains(elf + n); })) {
+                       [&](offset_t n) { return elves.contains(elf + n); })) {
             return elf;
         }
 
-        const auto valid{[&](pos_t dir) { return elves.contains(elf + dir); }};
+        const auto valid{
+            [&](offset_t dir) { return elves.contains(elf + dir); }};
         for (const auto& [step, checks] : dirs_copy) {
             if (r::none_of(checks, valid)) {
                 return elf + step;
@@ -94,11 +96,11 @@ aoc::solution_result day23(std::string_view input)
     }};
 
     const auto do_round{[&] {
-        std::map<pos_t, std::set<pos_t>> elves_by_proposal;
+        flat_hash_map<pos_t, small_vector<pos_t, 4>> elves_by_proposal;
         for (const auto& elf : elves) {
             auto proposal{propose(elf)};
             if (proposal != elf) {
-                elves_by_proposal[proposal].insert(elf);
+                elves_by_proposal[proposal].push_back(elf);
             }
         }
 
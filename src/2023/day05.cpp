@@ -6,12 +6,15 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_interval.hpp>
 #include <aoc_range.hpp>
 
 #include <fmt/ranges.h>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <string_view>
 #include <vector>
 
@@ -19,56 +22,8 @@ namespace aoc::year2023 {
 
 namespace {
 
-using range_map = std::map<std::int64_t, std::int64_t>;
-
-range_map flatten_section(const range_map::const_iterator first_section,
-                          const range_map& first,
-                          const range_map& second)
-{
-    range_map out;
-
-    auto first_left{first_section};
-    auto first_right{std::next(first_left)};
-    auto second_left{
-        std::prev(second.upper_bound(first_left->first + first_left->second))};
-    auto second_right{
-        first_right == first.end()
-            ? second.end()
-            : second.lower_bound(first_right->first + first_left->second)};
-
-    while (second_left != second_right && second_left != second.end() &&
-           (first_right == first.end() ||
-            (second_left->first - first_left->second < first_right->first))) {
-        auto key{std::max(first_left->first,
-                          second_left->first - first_left->second)};
-        out[key] = first_left->second + second_left->second;
-        second_left++;
-    }
-
-    return out;
-}
-
-range_map flatten_maps(const range_map& first, const range_map& second)
-{
-    range_map out;
-    auto first_iter{first.begin()};
-    auto second_iter{second.begin()};
-
-    if (first_iter == first.end()) {
-        throw input_error("empty 'first' map");
-    }
-    if (second_iter == second.end()) {
-        throw input_error("empty 'second' map");
-    }
-
-    // Merge a range from `first` will all the range sections of `second` it
-    // spans
-    for (auto iter{first_iter}; iter != first.end(); iter++) {
-        out.merge(flatten_section(iter, first, second));
-    }
-
-    return out;
-}
+// Each almanac map adds an offset to the numbers within each of its ranges.
+using offset_map = interval_map<std::int64_t, std::int64_t>;
 
 }  // namespace
 
@@ -79,58 +34,39 @@ aoc::solution_result day05(std::string_view input)
         numbers<std::int64_t>(lines[0].substr(7)) | r::to<std::vector>};
 
     const auto sections{lines | rv::drop(2) | rv::split("")};
-    std::vector<range_map> section_offset_maps;
 
+    // Compose the maps as they are read, so that the result maps each seed
+    // directly to its location.
+    offset_map flattened_map;
     for (auto&& section : sections) {
-        range_map section_offset_map;
-        section_offset_map[0] = 0;
+        offset_map section_offset_map;
         for (auto line : section | rv::drop(1)) {
             std::array<std::int64_t, 3> nums;
             auto& [dest, src, count]{nums};
             r::copy(numbers<std::int64_t>(line), nums.begin());
 
-            section_offset_map[src] = dest - src;
-            section_offset_map[src + count];  // Initialize to 0 if not present
+            section_offset_map.assign({src, src + count}, dest - src);
         }
-        section_offset_maps.emplace_back(std::move(section_offset_map));
+        flattened_map = compose_offsets(flattened_map, section_offset_map);
     }
 
-    range_map flattened_map{{{0LL, 0LL}}};
-    for (const auto& map : section_offset_maps /* | rv::take(3)*/) {
-        flattened_map = flatten_maps(flattened_map, map);
-    }
-
-    auto apply_map_func{[](const range_map& map) {
-        return [&](std::int64_t key) {
-            return key + std::prev(map.upper_bound(key))->second;
-        };
+    const auto location{[&](std::int64_t seed) {
+        return seed + flattened_map.at(seed);
     }};
+    const std::int64_t part1{r::min(initial_seeds | rv::transform(location))};
 
-    const std::int64_t part1{
-        r::min(initial_seeds | rv::transform(apply_map_func(flattened_map)))};
-
-    auto pairs{initial_seeds | rv::chunk(2) | rv::transform([](auto&& p) {
-                   return std::pair<std::int64_t, std::int64_t>{p[0], p[1]};
-               })};
-    std::map<std::int64_t, bool> seed_range_map{{0, false}};
-    for (const auto& [seed, length] : pairs) {
-        seed_range_map[seed] = true;
-        seed_range_map.try_emplace(seed + length, false);
+    interval_set<std::int64_t> seed_ranges;
+    for (auto&& p : initial_seeds | rv::chunk(2)) {
+        seed_ranges.insert({p[0], p[0] + p[1]});
     }
 
-    std::int64_t part2{9999999999};
-    for (const auto& [key, value] : flattened_map) {
-        auto prev{key - 1};
-        if (prev >= 0) {
-            auto seed_bounds{*std::prev(seed_range_map.upper_bound(prev))};
-            if (seed_bounds.second) {
-                part2 = std::min(part2, apply_map_func(flattened_map)(prev));
-            }
-        }
-        auto seed_bounds{*std::prev(seed_range_map.upper_bound(key))};
-        if (seed_bounds.second) {
-            part2 = std::min(part2, apply_map_func(flattened_map)(key));
-        }
+    // Locations increase within each piece of the map, so the lowest location
+    // is at the start of a piece or of a range of seeds.
+    std::int64_t part2{std::numeric_limits<std::int64_t>::max()};
+    for (const auto& seeds : seed_ranges) {
+        flattened_map.for_each(seeds, [&](auto piece, std::int64_t offset) {
+            part2 = std::min(part2, piece.lo + offset);
+        });
     }
 
     return {part1, part2};
@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
 #include <aoc_range.hpp>
 
 #include <algorithm>
@@ -32,7 +33,7 @@ int instruction_as_index(char instruction)
 }
 
 using map_t =
-    std::unordered_map<std::string_view, std::array<std::string_view, 2>>;
+    aoc::flat_hash_map<std::string_view, std::array<std::string_view, 2>>;
 
 map_t::value_type parse_node(std::string_view line)
 {
@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_arena.hpp>
 #include <aoc_graph.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
@@ -15,6 +16,7 @@
 #include <algorithm>
 #include <deque>
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <string_view>
 #include <vector>
@@ -112,7 +114,7 @@ void fill_start_pipe_char(grid_t& grid, pos_t start)
 
 void flood_fill(const grid_t& grid, pos_t pos, char c)
 {
-    std::set<pos_t> to_fill{pos};
+    std::pmr::set<pos_t> to_fill{{pos}, arena_resource()};
     while (!to_fill.empty()) {
         pos_t filling{r::front(to_fill)};
         auto neighbors{cardinal_directions |
@@ -180,7 +182,8 @@ aoc::solution_result day10(std::string_view input)
 
     fill_start_pipe_char(grid, start);
 
-    std::map<pos_t, int> visited_distances{{start, 0}};
+    std::pmr::map<pos_t, int> visited_distances{{{start, 0}},
+                                                arena_resource()};
     std::deque<pos_t> to_visit{actual_neighbors(grid, start) |
                                r::to<std::deque>};
     while (!to_visit.empty()) {
@@ -35,21 +35,20 @@ grid_t parse_grid(std::string_view input)
     return grid;
 }
 
-const auto equals_char{[](char c) { return [c](char c2) { return c == c2; }; }};
-const auto empty_range{
-    [](auto&& rng) -> bool { return r::all_of(rng, equals_char('.')); }};
-
-std::vector<std::int64_t> new_rng_map(auto&& rng, std::int64_t expansion_factor)
+// Map each row of `grid` to its coordinate after every row containing only
+// empty space has been expanded `expansion_factor` times.
+std::vector<std::int64_t> expanded_rows(const grid_t& grid,
+                                        std::int64_t expansion_factor)
 {
     std::vector<std::int64_t> out;
 
-    out.resize(rng.size());
+    out.resize(static_cast<std::size_t>(grid.height()));
     std::int64_t offset{0};
     for (int i{0}; i < static_cast<int>(out.size()); i++) {
-        if (empty_range(rng[i])) {
+        if (row_all_of(grid, i, '.')) {
             offset += (expansion_factor - 1);
         }
-        out[i] = offset;
+        out[static_cast<std::size_t>(i)] = offset;
         offset++;
     }
 
@@ -69,11 +68,14 @@ aoc::solution_result day11(std::string_view input)
         return manhattan_distance(std::get<0>(rng), std::get<1>(rng));
     }};
 
+    // Columns are scanned as the rows of a transposed copy.
+    const auto grid_columns{transposed(grid)};
+
     const auto solve_for_expansion_factor{[&](std::int64_t expansion_factor) {
         std::vector<std::int64_t> new_col_map{
-            new_rng_map(grid.cols(), expansion_factor)};
+            expanded_rows(grid_columns, expansion_factor)};
         std::vector<std::int64_t> new_row_map{
-            new_rng_map(grid.rows(), expansion_factor)};
+            expanded_rows(grid, expansion_factor)};
 
         std::vector<pos_t2> galaxy_positions;
         for (pos_t pos : grid.area().all_points()) {
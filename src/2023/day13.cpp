@@ -8,12 +8,10 @@
 #include <aoc.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
-#include <coro_generator.hpp>
 
 #include <fmt/ranges.h>
 
-#include <algorithm>
-#include <set>
+#include <cstddef>
 #include <string_view>
 #include <vector>
 
@@ -22,7 +20,6 @@ namespace aoc::year2023 {
 namespace {
 
 using grid_t = dynamic_grid<char>;
-using pos_t = vec2<int>;
 
 grid_t parse_grid(std::vector<std::string_view> lines)
 {
@@ -44,80 +41,53 @@ std::vector<grid_t> parse_grids(std::string_view input)
            r::to<std::vector>;
 }
 
-auto is_mirror{[](auto&& line) {
-    auto middle{r::distance(line) / 2};
-    return r::equal(line | rv::take(middle),
-                    line | rv::reverse | rv::take(middle));
-}};
-
-Generator<int> find_reflections(auto lines)
+// Total number of cells which differ between each row above `split` and its
+// mirror image below `split`, stopping early once `limit` is exceeded.
+std::size_t reflection_difference(const grid_t& grid,
+                                  int split,
+                                  std::size_t limit)
 {
-    int length{static_cast<int>(r::distance(lines[0]))};
-    for (int split{1}; split < length; split++) {
-        int after{length - split};
-        int start{0};
-        int end{length};
-        if (after > split) {
-            end = split * 2;
-        }
-        else {
-            start = split - after;
-        }
-        int width{end - start};
-        auto adjusted_rows{lines | rv::transform([&](auto&& line) {
-                               return line | rv::drop(start) | rv::take(width) | r::to<std::vector>;
-                           })};
+    std::size_t difference{0};
+    for (int above{split - 1}, below{split};
+         above >= 0 && below < grid.height() && difference <= limit;
+         above--, below++) {
+        difference += row_difference(grid, above, below);
+    }
+    return difference;
+}
 
-        if (r::all_of(adjusted_rows, is_mirror)) {
-            co_yield split;
+// Sum of every horizontal line of reflection in `grid` which would be perfect
+// after fixing exactly `smudges` cells, counted as the number of rows above it.
+int sum_reflections(const grid_t& grid, std::size_t smudges)
+{
+    int sum{0};
+    for (int split{1}; split < grid.height(); split++) {
+        if (reflection_difference(grid, split, smudges) == smudges) {
+            sum += split;
         }
     }
+    return sum;
 }
 
 }  // namespace
 
 aoc::solution_result day13(std::string_view input)
 {
-    auto grids{parse_grids(trim(input))};
-
-    int part1{0};
-    for (const grid_t& grid : grids) {
-        for (int i : find_reflections(grid.rows())) {
-            part1 += i;
-        }
-        for (int i : find_reflections(grid.cols())) {
-            part1 += i * 100;
-        }
-    }
-
-    int part2{0};
-    for (const grid_t& grid : grids) {
-        std::vector<int> original_reflections;
-        for (int i : find_reflections(grid.rows())) {
-            original_reflections.push_back(i);
-        }
-        for (int i : find_reflections(grid.cols())) {
-            original_reflections.push_back(i * 100);
+    const auto grids{parse_grids(trim(input))};
+
+    // Vertical lines of reflection are found as horizontal lines in the
+    // transposed grid, so that columns are compared as contiguous rows.
+    const auto summarize{[&](std::size_t smudges) {
+        int sum{0};
+        for (const grid_t& grid : grids) {
+            sum += sum_reflections(transposed(grid), smudges);
+            sum += sum_reflections(grid, smudges) * 100;
         }
+        return sum;
+    }};
 
-        auto copy{grid};
-            std::set<int> new_reflections;
-        for (pos_t pos : copy.area().all_points()) {
-            char& c{copy[pos]};
-            c = (c == '.') ? '#' : '.';
-            for (int i : find_reflections(copy.rows())) {
-                new_reflections.insert(i);
-            }
-            for (int i : find_reflections(copy.cols())) {
-                new_reflections.insert(i * 100);
-            }
-            c = (c == '.') ? '#' : '.';
-        }
-        for (int i : original_reflections) {
-            new_reflections.erase(i);
-        }
-        part2 += r::accumulate(new_reflections, 0);
-    }
+    const int part1{summarize(0)};
+    const int part2{summarize(1)};
 
     return {part1, part2};
 }
@@ -6,14 +6,15 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_cycle.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
 
 #include <fmt/ranges.h>
 
 #include <algorithm>
+#include <optional>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 namespace aoc::year2023 {
@@ -97,22 +98,6 @@ int_t calculate_load(const grid_t& grid)
                          int_t{0});
 }
 
-std::size_t hash_char_range(auto&& rng) {
-    std::size_t hash{0};
-    for (char c : rng) {
-        hash = hash ^ (c << 1);
-    }
-    return hash;
-}
-
-struct hash_grid
-{
-    std::size_t operator()(const grid_t& grid) const noexcept
-    {
-        return hash_char_range(grid.data());
-    }
-};
-
 }  // namespace
 
 aoc::solution_result day14(std::string_view input)
@@ -123,24 +108,19 @@ aoc::solution_result day14(std::string_view input)
     tilt_north(part1_grid);
     int_t part1{calculate_load(part1_grid)};
 
+    // Record a fingerprint of the grid before each spin until one repeats,
+    // then map the billionth spin back into the first pass through the cycle.
     grid_t part2_grid{grid};
-    int_t spin_count{0};
-
-    std::unordered_map<grid_t, int_t, hash_grid> when_encountered;
+    cycle_detector<> detector;
     std::vector<int_t> loads;
-    
-    while (!when_encountered.contains(part2_grid)) {
-        when_encountered[part2_grid] = spin_count;
+    std::optional<cycle> spin_cycle;
+    while (!(spin_cycle = detector.record(grid_fingerprint(part2_grid)))) {
         loads.push_back(calculate_load(part2_grid));
         spin_once(part2_grid);
-        spin_count++;
     }
 
-    int_t cycle_period{spin_count - when_encountered.at(part2_grid)};
-    int_t cycle_count{(1000000000-spin_count) / cycle_period + 1};
-    int_t part2_solution_spin_count{1000000000 - (cycle_count * cycle_period)};
-    int_t part2{loads[part2_solution_spin_count]};
-    
+    int_t part2{loads[spin_cycle->equivalent_step(1000000000)]};
+
     return {part1, part2};
 }
 
@@ -9,6 +9,7 @@
 #include <aoc_graph.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
+#include <small_vector.hpp>
 
 #include <algorithm>
 #include <string_view>
@@ -59,10 +60,12 @@ constexpr const pos_t west{-1, 0};
 constexpr const pos_t east{1, 0};
 constexpr const std::array<pos_t, 4> directions{north, south, west, east};
 
-auto neighbors(const crucible_state& state,
-               const grid_t& grid,
-               int min_forward,
-               int max_forward)
+using neighbors_t = small_vector<crucible_queue_entry, 4>;
+
+neighbors_t neighbors(const crucible_state& state,
+                      const grid_t& grid,
+                      int min_forward,
+                      int max_forward)
 {
     if (state.direction_moves > 0 && state.direction_moves < min_forward) {
         crucible_queue_entry out;
@@ -71,11 +74,11 @@ auto neighbors(const crucible_state& state,
         vert.pos += vert.direction;
         if (!grid.area().contains(vert.pos)) {
             // Can't move at all; return empty vector
-            return std::vector<crucible_queue_entry>{};
+            return {};
         }
         dist += grid[vert.pos];
         vert.direction_moves++;
-        return std::vector<crucible_queue_entry>{out};
+        return {out};
     }
 
     std::array<crucible_queue_entry, 4> out{};
@@ -98,10 +101,11 @@ auto neighbors(const crucible_state& state,
                grid.area().contains(e.vert.pos) &&
                (e.vert.direction != (state.direction * -1));
     }};
-    auto out_vec{out | rv::filter(filter) | r::to<std::vector>};
-    for (crucible_queue_entry& e : out_vec) {
+    neighbors_t out_vec;
+    for (crucible_queue_entry& e : out | rv::filter(filter)) {
         auto& [vert, dist]{e};
         dist += grid[vert.pos];
+        out_vec.push_back(e);
     }
     return out_vec;
 }
@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_arena.hpp>
 #include <aoc_braille.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
@@ -15,6 +16,7 @@
 #include <fmt/ranges.h>
 
 #include <algorithm>
+#include <memory_resource>
 #include <set>
 #include <string_view>
 #include <vector>
@@ -110,7 +112,7 @@ pos_t right_hand_direction(pos_t p)
 
 void flood_fill(const grid_t& grid, pos_t pos, char c)
 {
-    std::set<pos_t> to_fill{pos};
+    std::pmr::set<pos_t> to_fill{{pos}, arena_resource()};
     while (!to_fill.empty()) {
         pos_t filling{r::front(to_fill)};
         auto neighbors{cardinal_directions |
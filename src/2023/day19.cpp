@@ -6,14 +6,17 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
+#include <aoc_interval.hpp>
 #include <aoc_range.hpp>
 
 #include <fmt/ranges.h>
 
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <span>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 namespace aoc::year2023 {
@@ -45,7 +48,7 @@ rule_t parse_rule(std::string_view s)
 
 using workflow_t = std::pair<std::string_view, std::vector<rule_t>>;
 using workflow_map_t =
-    std::unordered_map<workflow_t::first_type, workflow_t::second_type>;
+    aoc::flat_hash_map<workflow_t::first_type, workflow_t::second_type>;
 
 workflow_t parse_workflow(std::string_view line)
 {
@@ -132,29 +135,6 @@ int_t score_part(const part_t& part)
     return part.x + part.m + part.a + part.s;
 }
 
-std::vector<int_t> partition_variable_space(const workflow_map_t& workflows,
-                                            char var)
-{
-    std::vector<int_t> out;
-    out.push_back(1);
-    for (const auto& rules : workflows | rv::values) {
-        for (const rule_t& rule : rules) {
-            if (rule.var == var) {
-                if (rule.op == '<') {
-                    out.push_back(rule.value);
-                }
-                else {
-                    out.push_back(rule.value + 1);
-                }
-            }
-        }
-    }
-    out.push_back(4001);
-    r::sort(out);
-    out.erase(r::unique(out), out.end());
-    return out;
-}
-
 bool simplify_rules(std::vector<rule_t>& rules)
 {
     bool out{false};
@@ -202,6 +182,65 @@ void simplify_all_workflows(workflow_map_t& workflows)
     }
 }
 
+// Ranges of each variable (x, m, a and s) that a set of parts could have.
+using part_ranges_t = std::array<interval<int_t>, 4>;
+
+std::size_t var_index(char c)
+{
+    switch (c) {
+        case 'x':
+            return 0;
+        case 'm':
+            return 1;
+        case 'a':
+            return 2;
+        case 's':
+            return 3;
+    }
+    throw input_error(fmt::format("invalid variable: {}", c));
+}
+
+// Number of combinations of ratings within `ranges` that are accepted when
+// starting from workflow `name`.  Each rule splits the ranges into the
+// intervals which pass it and those which fall through to the next rule.
+int_t count_accepted(const workflow_map_t& workflows,
+                     std::string_view name,
+                     part_ranges_t ranges)
+{
+    if (name == "R") {
+        return 0;
+    }
+    if (name == "A") {
+        return r::accumulate(ranges | rv::transform(&interval<int_t>::length),
+                             int_t{1}, std::multiplies<>{});
+    }
+
+    int_t out{0};
+    for (const rule_t& rule : workflows.at(name)) {
+        if (rule.op == '!') {
+            return out + count_accepted(workflows, rule.next, ranges);
+        }
+
+        auto& range{ranges[var_index(rule.var)]};
+        const bool less{rule.op == '<'};
+        const interval<int_t> passing{less ? range.lo : rule.value + 1,
+                                      less ? rule.value : range.hi};
+        const interval<int_t> failing{less ? rule.value : range.lo,
+                                      less ? range.hi : rule.value + 1};
+        if (const auto passed{intersection(range, passing)}) {
+            auto next_ranges{ranges};
+            next_ranges[var_index(rule.var)] = *passed;
+            out += count_accepted(workflows, rule.next, next_ranges);
+        }
+        const auto failed{intersection(range, failing)};
+        if (!failed) {
+            return out;
+        }
+        range = *failed;
+    }
+    throw input_error("workflow has no fallback rule");
+}
+
 }  // namespace
 
 aoc::solution_result day19(std::string_view input)
@@ -226,32 +265,10 @@ aoc::solution_result day19(std::string_view input)
     int_t part1{r::accumulate(
         parts | rv::filter(filter_func) | rv::transform(score_part), 0)};
 
-    std::vector<int_t> partitioned_x{partition_variable_space(workflows, 'x')};
-    std::vector<int_t> partitioned_m{partition_variable_space(workflows, 'm')};
-    std::vector<int_t> partitioned_a{partition_variable_space(workflows, 'a')};
-    std::vector<int_t> partitioned_s{partition_variable_space(workflows, 's')};
-
-    int_t part2{0};
-    for (auto [x, x_max] : partitioned_x | rv::sliding(1) | rv::drop_last(1)) {
-        int_t x_len{*x_max - *x};
-
-        for (auto [m, m_max] : partitioned_m | rv::sliding(1) | rv::drop_last(1)) {
-            int_t m_len{*m_max - *m};
-
-            for (auto [a, a_max] : partitioned_a | rv::sliding(1) | rv::drop_last(1)) {
-                int_t a_len{*a_max - *a};
-
-                for (auto [s, s_max] : partitioned_s | rv::sliding(1) | rv::drop_last(1)) {
-                    int_t s_len{*s_max - *s};
-
-                    part_t part{*x, *m, *a, *s};
-                    if (accept_part(workflows, part)) {
-                        part2 += x_len * m_len * a_len * s_len;
-                    }
-                }
-            }
-        }
-    }
+    constexpr interval<int_t> rating_range{1, 4001};
+    const int_t part2{count_accepted(workflows, "in",
+                                     {rating_range, rating_range, rating_range,
+                                      rating_range})};
 
     return {part1, part2};
 }
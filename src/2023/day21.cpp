@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_flat_hash.hpp>
 #include <aoc_grid.hpp>
 #include <aoc_range.hpp>
 
@@ -15,7 +16,6 @@
 
 #include <algorithm>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 namespace aoc::year2023 {
@@ -92,19 +92,6 @@ grid_t expand_grid(const grid_t& grid)
     return out;
 }
 
-template <typename GridType>
-struct grid_hash {
-    std::size_t operator()(const GridType& grid) const noexcept
-    {
-        std::size_t h{std::hash<int>{}(grid.width())};
-        h = h * 37 + std::hash<int>{}(grid.height());
-        for (char c : grid.data()) {
-            h = h * 37 + std::hash<char>{}(c);
-        }
-        return h;
-    }
-};
-
 template <typename GridType>
 struct grid_equal {
     bool operator()(const GridType& a, const GridType& b) const noexcept
@@ -163,7 +150,7 @@ aoc::solution_result day21(std::string_view input)
     // print_grid(grids_by_step[0]);
 
     using SubgridType = decltype(expanded_grid.subgrid({1, 1}));
-    std::unordered_map<std::size_t, int> discovered_subgrid_indexes;
+    aoc::flat_hash_map<std::size_t, int> discovered_subgrid_indexes;
     std::vector<grid_t> discovered_subgrids_by_index;
     int current_discovery{0};
     const auto discover_subgrid{[&](const grid_t& grid, int subx, int suby) {
@@ -171,7 +158,7 @@ aoc::solution_result day21(std::string_view input)
             {{subx * start_grid.width(), suby * start_grid.height()},
              {start_grid.width(), start_grid.height()}})};
 
-        auto hash{grid_hash<decltype(subgrid)>{}(subgrid)};
+        auto hash{grid_hash{}(subgrid)};
         if (!discovered_subgrid_indexes.contains(hash)) {
             discovered_subgrid_indexes[hash] = current_discovery;
             discovered_subgrids_by_index.emplace_back(subgrid.width(),
@@ -246,7 +233,7 @@ aoc::solution_result day21(std::string_view input)
                     {{x * start_grid.width(), y * start_grid.height()},
                      {start_grid.width(), start_grid.height()}})};
 
-                auto hash{grid_hash<decltype(subgrid)>{}(subgrid)};
+                auto hash{grid_hash{}(subgrid)};
                 int index{discovered_subgrid_indexes.at(hash)};
                 if (subgrid_first_appearance[index] == -1) {
                     subgrid_first_appearance[index] = static_cast<int>(i);
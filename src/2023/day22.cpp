@@ -8,9 +8,9 @@
 #include <aoc.hpp>
 #include <aoc_range.hpp>
 
-#include <fmt/ranges.h>
-
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string_view>
 #include <vector>
 
@@ -20,33 +20,22 @@ namespace {
 
 using int_t = std::int64_t;
 
-std::array<int_t, 6> parse_numbers(std::string_view line) {
-    std::array<int_t, 6> out;
-    r::copy(numbers<int_t>(line), out.begin());
-    return out;
-}
+// Each brick's two corners: x1, y1, z1, x2, y2, z2
+using brick_columns = number_columns<int_t, 6>;
 
 struct numbers_min_max {
     std::array<int_t, 3> min;
     std::array<int_t, 3> max;
 };
 
-numbers_min_max find_bounds(const auto& all_numbers) {
-    auto first{r::front(all_numbers)};
-    numbers_min_max out{{first[0], first[1], first[2]},{first[0], first[1], first[2]}};
-    for (const auto& numbers : all_numbers) {
-        out.min[0] = std::min(out.min[0], numbers[0]);
-        out.min[0] = std::min(out.min[0], numbers[3]);
-        out.min[1] = std::min(out.min[1], numbers[1]);
-        out.min[1] = std::min(out.min[1], numbers[4]);
-        out.min[2] = std::min(out.min[2], numbers[2]);
-        out.min[2] = std::min(out.min[2], numbers[5]);
-        out.max[0] = std::max(out.max[0], numbers[0]);
-        out.max[0] = std::max(out.max[0], numbers[3]);
-        out.max[1] = std::max(out.max[1], numbers[1]);
-        out.max[1] = std::max(out.max[1], numbers[4]);
-        out.max[2] = std::max(out.max[2], numbers[2]);
-        out.max[2] = std::max(out.max[2], numbers[5]);
+numbers_min_max find_bounds(const brick_columns& bricks)
+{
+    numbers_min_max out;
+    for (std::size_t axis{0}; axis < 3; axis++) {
+        out.min[axis] = std::min(r::min(bricks.column(axis)),
+                                 r::min(bricks.column(axis + 3)));
+        out.max[axis] = std::max(r::max(bricks.column(axis)),
+                                 r::max(bricks.column(axis + 3)));
     }
     return out;
 }
@@ -55,13 +44,12 @@ numbers_min_max find_bounds(const auto& all_numbers) {
 
 aoc::solution_result day22(std::string_view input)
 {
-    input = trim(input);
-
-    fmt::print("{}\n", sv_lines(input) | rv::transform(parse_numbers));
-
-    auto [min, max]{find_bounds(sv_lines(input) | rv::transform(parse_numbers) ) };
-    fmt::print("Bounds: {} -> {}\n", min, max);
+    const auto bricks{parse_columns<int_t, 6>(trim(input))};
+    if (bricks.rows() == 0) {
+        throw input_error{"no bricks in input"};
+    }
 
+    [[maybe_unused]] const auto bounds{find_bounds(bricks)};
 
     return {"", ""};
 }
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "aoc_arena.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace aoc {
+
+arena::arena(std::size_t capacity)
+    : capacity_{capacity},
+      block_{std::make_unique_for_overwrite<std::byte[]>(capacity)}
+{
+    buffer_.emplace(block_.get(), capacity_, &overflow_);
+}
+
+void arena::reset()
+{
+    if (overflow_.allocated() == 0) {
+        // Everything fit in the block, so releasing it is just resetting the
+        // buffer's pointer.
+        buffer_->release();
+        return;
+    }
+
+    // Replace the block with one big enough for the last run, overflow and
+    // all.  The old buffer must go first, since it returns the overflow.
+    capacity_ += overflow_.allocated();
+    buffer_.reset();
+    overflow_.clear_count();
+    block_.reset();
+    block_ = std::make_unique_for_overwrite<std::byte[]>(capacity_);
+    buffer_.emplace(block_.get(), capacity_, &overflow_);
+}
+
+void* arena::overflow_resource::do_allocate(std::size_t bytes,
+                                            std::size_t alignment)
+{
+    void* p{std::pmr::new_delete_resource()->allocate(bytes, alignment)};
+    allocated_ += bytes;
+    return p;
+}
+
+void arena::overflow_resource::do_deallocate(void* p,
+                                             std::size_t bytes,
+                                             std::size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool arena::overflow_resource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+arena& solution_arena()
+{
+    static arena instance;
+    return instance;
+}
+
+}  // namespace aoc
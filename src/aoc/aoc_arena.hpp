@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_ARENA_HPP
+#define AOC_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace aoc {
+
+/// @brief Bump allocator for the scratch containers of a single solution run.
+///
+/// Allocation is a pointer increment into one block of memory, deallocation
+/// does nothing, and `reset()` makes the whole block available again at once.
+/// This suits the node-based sets and maps used for flood fills and memos,
+/// which otherwise spend much of their time in the general-purpose allocator
+/// and then again freeing every node.
+///
+/// If a run needs more than the block holds, the overflow comes from the heap
+/// and is counted; the next `reset()` grows the block to cover it, so repeated
+/// runs settle into a single block with no heap traffic at all.
+///
+/// Not thread-safe: use an arena only from one thread at a time.
+class arena {
+   public:
+    static constexpr std::size_t default_capacity{std::size_t{1} << 20};
+
+    explicit arena(std::size_t capacity = default_capacity);
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &*buffer_; }
+
+    template <typename T>
+    std::pmr::polymorphic_allocator<T> allocator() noexcept
+    {
+        return std::pmr::polymorphic_allocator<T>{resource()};
+    }
+
+    /// @brief Release everything allocated from the arena.  Any container
+    /// still using it must not be used afterward, not even to destroy it.
+    void reset();
+
+    /// @brief Size of the arena's block, not counting any overflow.
+    std::size_t capacity() const noexcept { return capacity_; }
+
+   private:
+    // Upstream of the block, recording how much overflowed it.
+    class overflow_resource : public std::pmr::memory_resource {
+       public:
+        std::size_t allocated() const noexcept { return allocated_; }
+        void clear_count() noexcept { allocated_ = 0; }
+
+       private:
+        std::size_t allocated_{0};
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p,
+                           std::size_t bytes,
+                           std::size_t alignment) override;
+        bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::size_t capacity_;
+    std::unique_ptr<std::byte[]> block_;
+    overflow_resource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> buffer_;
+};
+
+/// @brief The arena for solution scratch space, which the runner resets
+/// between runs.  A solution opts in by constructing its containers with
+/// `arena_resource()`, e.g.
+///
+///     std::pmr::set<pos_t> to_fill{aoc::arena_resource()};
+///
+/// Anything allocated from it must be gone by the time the solution returns.
+arena& solution_arena();
+
+inline std::pmr::memory_resource* arena_resource()
+{
+    return solution_arena().resource();
+}
+
+}  // namespace aoc
+
+#endif  // AOC_ARENA_HPP
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_BOX_SET_HPP
+#define AOC_BOX_SET_HPP
+
+#include "aoc_vec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace aoc {
+
+/// @brief Axis-aligned box in `Dims` dimensions, spanning `lo` (inclusive) to
+/// `hi` (exclusive) on each axis.
+template <typename Scalar, std::size_t Dims>
+struct box {
+    std::array<Scalar, Dims> lo{};
+    std::array<Scalar, Dims> hi{};
+
+    bool empty() const noexcept
+    {
+        for (std::size_t i{0}; i < Dims; i++) {
+            if (lo[i] >= hi[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::int64_t volume() const noexcept
+    {
+        std::int64_t out{1};
+        for (std::size_t i{0}; i < Dims; i++) {
+            out *= static_cast<std::int64_t>(hi[i]) - lo[i];
+        }
+        return out;
+    }
+
+    friend auto operator<=>(const box&, const box&) noexcept = default;
+};
+
+template <typename Scalar, std::size_t Dims>
+std::optional<box<Scalar, Dims>> intersection(
+    const box<Scalar, Dims>& a,
+    const box<Scalar, Dims>& b) noexcept
+{
+    box<Scalar, Dims> out;
+    for (std::size_t i{0}; i < Dims; i++) {
+        out.lo[i] = std::max(a.lo[i], b.lo[i]);
+        out.hi[i] = std::min(a.hi[i], b.hi[i]);
+    }
+    if (out.empty()) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+template <typename Scalar>
+box<Scalar, 2> box_from_rect(const rect<Scalar>& r) noexcept
+{
+    return {{r.base.x, r.base.y},
+            {static_cast<Scalar>(r.base.x + r.dimensions.x),
+             static_cast<Scalar>(r.base.y + r.dimensions.y)}};
+}
+
+// Box containing every point from `corner1` to `corner2`, inclusive.
+template <typename Scalar>
+box<Scalar, 3> box_from_corners(const vec3<Scalar>& corner1,
+                                const vec3<Scalar>& corner2) noexcept
+{
+    return {{std::min(corner1.x, corner2.x), std::min(corner1.y, corner2.y),
+             std::min(corner1.z, corner2.z)},
+            {static_cast<Scalar>(std::max(corner1.x, corner2.x) + 1),
+             static_cast<Scalar>(std::max(corner1.y, corner2.y) + 1),
+             static_cast<Scalar>(std::max(corner1.z, corner2.z) + 1)}};
+}
+
+/// @brief Set of points formed by adding and removing boxes, such as the
+/// cuboids of reactor cubes turned on and off in 2021 day 22.
+///
+/// The set is represented by inclusion-exclusion: a collection of boxes with
+/// signed counts, such that the count of a point in the set is one and of a
+/// point outside it is zero.  Inserting or subtracting a box cancels out its
+/// overlap with every existing box, so memory grows with the number of
+/// distinct overlaps rather than the volume of the boxes.  Identical boxes are
+/// merged and boxes whose counts cancel to zero are dropped.
+template <typename Scalar, std::size_t Dims>
+class box_set {
+   public:
+    using box_type = box<Scalar, Dims>;
+
+    void insert(const box_type& b) { update(b, true); }
+    void subtract(const box_type& b) { update(b, false); }
+
+    /// @brief Number of points in the set.
+    std::int64_t volume() const noexcept
+    {
+        std::int64_t out{0};
+        for (const auto& [b, count] : boxes_) {
+            out += count * b.volume();
+        }
+        return out;
+    }
+
+    /// @brief Number of points in the set which are also within `region`.
+    std::int64_t volume_within(const box_type& region) const noexcept
+    {
+        std::int64_t out{0};
+        for (const auto& [b, count] : boxes_) {
+            if (const auto overlap{intersection(b, region)}) {
+                out += count * overlap->volume();
+            }
+        }
+        return out;
+    }
+
+    /// @brief Number of signed boxes used to represent the set.
+    std::size_t box_count() const noexcept { return boxes_.size(); }
+
+   private:
+    std::map<box_type, std::int64_t> boxes_;
+
+    void update(const box_type& b, bool include)
+    {
+        if (b.empty()) {
+            return;
+        }
+
+        // Whatever part of the set was already in `b` is removed, so that
+        // afterward `b` is either entirely in the set (counted once, by `b`
+        // itself) or entirely out of it.
+        std::map<box_type, std::int64_t> changes;
+        for (const auto& [existing, count] : boxes_) {
+            if (const auto overlap{intersection(existing, b)}) {
+                changes[*overlap] -= count;
+            }
+        }
+        if (include) {
+            changes[b] += 1;
+        }
+
+        for (const auto& [changed, delta] : changes) {
+            const auto [iter, inserted]{boxes_.try_emplace(changed, delta)};
+            if (!inserted) {
+                iter->second += delta;
+            }
+            if (iter->second == 0) {
+                boxes_.erase(iter);
+            }
+        }
+    }
+};
+
+}  // namespace aoc
+
+#endif  // AOC_BOX_SET_HPP
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_CYCLE_HPP
+#define AOC_CYCLE_HPP
+
+#include "aoc_flat_hash.hpp"
+#include "aoc_hash.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace aoc {
+
+/// @brief A cycle in a sequence of states x0, x1, x2, ... where each state is
+/// produced from the previous one by the same transition function.
+struct cycle {
+    /// Index of the first state which is part of the cycle ("mu").
+    std::size_t offset{};
+    /// Number of states in the cycle ("lambda").
+    std::size_t period{};
+
+    /// @brief Map step `n` to the earliest step with the same state, which is
+    /// always less than `offset + period`.
+    std::size_t equivalent_step(std::size_t n) const noexcept
+    {
+        return n < offset ? n : offset + (n - offset) % period;
+    }
+
+    friend bool operator==(const cycle&, const cycle&) noexcept = default;
+};
+
+/// @brief Brent's cycle detection algorithm.  Only two states are kept at a
+/// time, at the cost of running the transition about three times per step of
+/// `offset + period`.
+/// @tparam State Copyable state type.
+/// @tparam Step Callable taking a `State&` and advancing it by one step.
+/// @tparam Key Projection from a `State` to the value which is compared to
+/// decide if two states are the same; for example a fingerprint, which is
+/// cheaper to compare than a large state.
+/// @param start The initial state, x0.
+/// @param step The transition function.
+/// @param key The projection.
+template <typename State, typename Step, typename Key = std::identity>
+cycle find_cycle_brent(const State& start, Step&& step, Key&& key = {})
+{
+    // Find the period by racing the hare ahead of the tortoise, teleporting
+    // the tortoise to the hare each time the distance reaches a power of two.
+    std::size_t power{1};
+    std::size_t period{1};
+    State tortoise{start};
+    State hare{start};
+    step(hare);
+    auto tortoise_key{std::invoke(key, tortoise)};
+    while (tortoise_key != std::invoke(key, hare)) {
+        if (power == period) {
+            tortoise = hare;
+            tortoise_key = std::invoke(key, tortoise);
+            power *= 2;
+            period = 0;
+        }
+        step(hare);
+        period++;
+    }
+
+    // Find the offset by starting the hare `period` steps ahead of the
+    // tortoise and advancing both until they meet.
+    tortoise = start;
+    hare = start;
+    for (std::size_t i{0}; i < period; i++) {
+        step(hare);
+    }
+    std::size_t offset{0};
+    while (std::invoke(key, tortoise) != std::invoke(key, hare)) {
+        step(tortoise);
+        step(hare);
+        offset++;
+    }
+
+    return {offset, period};
+}
+
+/// @brief Cycle detection by remembering a fingerprint of every state seen.
+/// Unlike `find_cycle_brent` the caller drives the steps, so the caller can
+/// record anything else it needs about each state (such as a score) along the
+/// way, and each state is only computed once.
+/// @tparam Fingerprint Hashable, equality-comparable summary of a state.
+template <typename Fingerprint = fingerprint>
+class cycle_detector {
+   public:
+    /// @brief Record the state at the next step (starting from step 0) by its
+    /// fingerprint.
+    /// @return The cycle, if this state has been recorded before.  In that case
+    /// the step is not counted, so `steps()` remains `offset + period`.
+    std::optional<cycle> record(const Fingerprint& f)
+    {
+        const auto [iter, inserted]{seen_.try_emplace(f, steps_)};
+        if (!inserted) {
+            return cycle{iter->second, steps_ - iter->second};
+        }
+        steps_++;
+        return std::nullopt;
+    }
+
+    /// @brief Number of distinct states recorded so far.
+    std::size_t steps() const noexcept { return steps_; }
+
+   private:
+    flat_hash_map<Fingerprint, std::size_t> seen_;
+    std::size_t steps_{0};
+};
+
+}  // namespace aoc
+
+#endif  // AOC_CYCLE_HPP
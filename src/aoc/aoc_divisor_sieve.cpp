@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "aoc_divisor_sieve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+void divisor_sigma_sieve::fill(std::uint64_t first,
+                               std::span<std::uint64_t> sums) const
+{
+    std::ranges::fill(sums, 0);
+    const std::uint64_t last{first + sums.size()};
+    for (std::uint64_t d{1}; d * d < last; d++) {
+        // The multiples n = d * k with k >= d, from the first in the segment.
+        std::uint64_t k{std::max(d, (first + d - 1) / d)};
+        const bool count_d_as_pair{d <= max_multiple_};
+        for (std::uint64_t n{d * k}; n < last; n += d, k++) {
+            auto& sum{sums[n - first]};
+            if (k <= max_multiple_) {
+                sum += d;
+            }
+            if (k != d && count_d_as_pair) {
+                sum += k;
+            }
+        }
+    }
+}
+
+std::uint64_t divisor_sigma_sieve::find_first(std::uint64_t target,
+                                              std::size_t threads) const
+{
+    const auto search_segment{[&](std::int64_t first, std::int64_t last) {
+        std::vector<std::uint64_t> sums(static_cast<std::size_t>(last - first));
+        fill(static_cast<std::uint64_t>(first), sums);
+        const auto found{std::ranges::find_if(
+            sums, [target](std::uint64_t sum) { return sum >= target; })};
+        return std::array{found == sums.end()
+                              ? no_match
+                              : first + (found - sums.begin())};
+    }};
+    const auto found{parallel_find_first<1>(
+        1, static_cast<std::int64_t>(segment_size), search_segment, threads)};
+    return static_cast<std::uint64_t>(found[0]);
+}
+
+}  // namespace aoc
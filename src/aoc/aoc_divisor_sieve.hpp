@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_DIVISOR_SIEVE_HPP
+#define AOC_DIVISOR_SIEVE_HPP
+
+#include "aoc_parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace aoc {
+
+/// @brief Sums of divisors, σ(n), computed a segment of `n` at a time.
+///
+/// Each divisor pair `d * k = n` with `d <= k` is visited once, from the
+/// smaller divisor, so a segment below `N` costs about `len * ln(sqrt(N))`
+/// additions and needs no memory beyond the segment itself.
+///
+/// Optionally a divisor `d` only counts if `n` is among its first
+/// `max_multiple` multiples, that is if `n / d <= max_multiple`.
+class divisor_sigma_sieve {
+   public:
+    static constexpr std::uint64_t unlimited{
+        std::numeric_limits<std::uint64_t>::max()};
+    /// @brief Numbers per segment; the sums of a segment fit in L2 cache.
+    static constexpr std::size_t segment_size{std::size_t{1} << 15};
+
+    explicit divisor_sigma_sieve(std::uint64_t max_multiple = unlimited)
+        : max_multiple_{max_multiple}
+    {
+    }
+
+    /// @brief Set `sums[i]` to the sum of the divisors of `first + i`, and
+    /// to zero for zero.
+    void fill(std::uint64_t first, std::span<std::uint64_t> sums) const;
+
+    /// @brief The first `n` from 1 upward whose divisor sum is at least
+    /// `target`, searching segments on `threads` threads.  There always is
+    /// one, since `n` is a divisor of itself.
+    std::uint64_t find_first(std::uint64_t target,
+                             std::size_t threads = worker_count()) const;
+
+   private:
+    std::uint64_t max_multiple_;
+};
+
+}  // namespace aoc
+
+#endif  // AOC_DIVISOR_SIEVE_HPP
@@ -0,0 +1,765 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_FLAT_HASH_HPP
+#define AOC_FLAT_HASH_HPP
+
+#include "aoc_hash.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_FLAT_HASH_SSE2
+#endif
+
+// Open-addressing hash tables in the style of Abseil's Swiss tables.  Elements
+// live directly in one array of slots, and a parallel array holds one control
+// byte per slot: empty, deleted, or the low 7 bits of the hash of the element
+// in that slot.  A lookup loads the control bytes of 16 slots at once and
+// compares all of them with the 7 hash bits in one instruction, so it usually
+// touches a single key.  Compared with std::unordered_map there is no node
+// allocation per element and no pointer chasing.
+//
+// Migrating from std::map or std::unordered_map:
+// - The key needs a `std::hash` specialization and `==` rather than `<`.  The
+//   default hasher `aoc::hash` mixes whatever `std::hash` returns, so a weak
+//   `std::hash` (such as the identity on integers) is fine.
+// - Iteration order is unspecified, so a day which relies on sorted keys
+//   (first/last key, ordered output) should stay on std::map.
+// - Inserting or erasing invalidates iterators and references to elements,
+//   and `rehash`/`reserve` move every element.
+// - Measure it: for a few hundred keys std::map is often just as fast, and a
+//   flat table only pays off once the map is large or probed in a hot loop.
+
+namespace aoc {
+
+namespace detail {
+
+using ctrl_t = std::int8_t;
+
+// Full slots have a non-negative control byte (the 7 hash bits), so the three
+// special values all have the sign bit set.  The sentinel past the last slot
+// stops iteration.
+inline constexpr ctrl_t ctrl_empty{-128};
+inline constexpr ctrl_t ctrl_deleted{-2};
+inline constexpr ctrl_t ctrl_sentinel{-1};
+
+// Control bytes of one group of slots, with masks of the matching slots (bit
+// `i` set for slot `i` of the group).
+class ctrl_group {
+   public:
+    static constexpr std::size_t width{16};
+
+#if defined(AOC_FLAT_HASH_SSE2)
+    explicit ctrl_group(const ctrl_t* p) noexcept
+        : ctrl_{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}
+    {
+    }
+
+    std::uint32_t match(ctrl_t h2) const noexcept
+    {
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2))));
+    }
+
+    // Empty or deleted slots, which are exactly those with the sign bit set.
+    std::uint32_t match_free() const noexcept
+    {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_));
+    }
+
+   private:
+    __m128i ctrl_;
+#else
+    explicit ctrl_group(const ctrl_t* p) noexcept
+    {
+        std::memcpy(ctrl_, p, width);
+    }
+
+    std::uint32_t match(ctrl_t h2) const noexcept
+    {
+        std::uint32_t mask{0};
+        for (std::size_t i{0}; i < width; i++) {
+            mask |= std::uint32_t{ctrl_[i] == h2} << i;
+        }
+        return mask;
+    }
+
+    std::uint32_t match_free() const noexcept
+    {
+        std::uint32_t mask{0};
+        for (std::size_t i{0}; i < width; i++) {
+            mask |= std::uint32_t{ctrl_[i] < 0} << i;
+        }
+        return mask;
+    }
+
+   private:
+    ctrl_t ctrl_[width];
+#endif
+
+   public:
+    std::uint32_t match_empty() const noexcept { return match(ctrl_empty); }
+};
+
+// Table with policies for how to get the key out of an element, shared by
+// flat_hash_set and flat_hash_map.
+template <typename Policy, typename Hash, typename Eq>
+class raw_hash_table {
+   public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    template <bool Const>
+    class iterator_impl {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = raw_hash_table::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference =
+            std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer =
+            std::conditional_t<Const, const value_type*, value_type*>;
+
+        iterator_impl() = default;
+
+        // Allow iterator to const_iterator conversion.
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        iterator_impl(const iterator_impl<OtherConst>& other) noexcept
+            : ctrl_{other.ctrl_}, slot_{other.slot_}
+        {
+        }
+
+        reference operator*() const noexcept { return *slot_; }
+        pointer operator->() const noexcept { return slot_; }
+
+        iterator_impl& operator++() noexcept
+        {
+            ++ctrl_;
+            ++slot_;
+            skip_free();
+            return *this;
+        }
+
+        iterator_impl operator++(int) noexcept
+        {
+            iterator_impl out{*this};
+            ++*this;
+            return out;
+        }
+
+        friend bool operator==(const iterator_impl& lhs,
+                               const iterator_impl& rhs) noexcept
+        {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+       private:
+        friend class raw_hash_table;
+        template <bool>
+        friend class iterator_impl;
+
+        iterator_impl(const ctrl_t* ctrl, pointer slot) noexcept
+            : ctrl_{ctrl}, slot_{slot}
+        {
+        }
+
+        // Advance to the next full slot, or to the sentinel.
+        void skip_free() noexcept
+        {
+            while (*ctrl_ < ctrl_sentinel) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        const ctrl_t* ctrl_{nullptr};
+        pointer slot_{nullptr};
+    };
+
+    using iterator = iterator_impl<Policy::constant_iterators>;
+    using const_iterator = iterator_impl<true>;
+
+    raw_hash_table() = default;
+
+    raw_hash_table(const raw_hash_table& other)
+        : hash_{other.hash_}, eq_{other.eq_}
+    {
+        if (other.empty()) {
+            return;
+        }
+        reserve(other.size_);
+        for (const value_type& v : other) {
+            const std::size_t hash{hash_(Policy::key(v))};
+            const std::size_t i{find_free_slot(hash)};
+            std::construct_at(slots_ + i, v);
+            set_full(i, hash);
+        }
+    }
+
+    raw_hash_table(raw_hash_table&& other) noexcept
+        : ctrl_{std::exchange(other.ctrl_, nullptr)},
+          slots_{std::exchange(other.slots_, nullptr)},
+          capacity_{std::exchange(other.capacity_, 0)},
+          size_{std::exchange(other.size_, 0)},
+          growth_left_{std::exchange(other.growth_left_, 0)},
+          hash_{std::move(other.hash_)},
+          eq_{std::move(other.eq_)}
+    {
+    }
+
+    raw_hash_table& operator=(const raw_hash_table& other)
+    {
+        if (this != &other) {
+            raw_hash_table copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+
+    raw_hash_table& operator=(raw_hash_table&& other) noexcept
+    {
+        raw_hash_table moved{std::move(other)};
+        swap(moved);
+        return *this;
+    }
+
+    ~raw_hash_table() { destroy(); }
+
+    iterator begin() noexcept
+    {
+        iterator out{ctrl_, slots_};
+        if (ctrl_) {
+            out.skip_free();
+        }
+        return out;
+    }
+    const_iterator begin() const noexcept
+    {
+        return const_cast<raw_hash_table&>(*this).begin();
+    }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept
+    {
+        return {ctrl_ + capacity_, slots_ + capacity_};
+    }
+    const_iterator end() const noexcept
+    {
+        return const_cast<raw_hash_table&>(*this).end();
+    }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    // Destroys every element but keeps the slots for reuse.
+    void clear() noexcept
+    {
+        if (capacity_ == 0) {
+            return;
+        }
+        destroy_elements();
+        std::memset(ctrl_, static_cast<unsigned char>(ctrl_empty), capacity_);
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    // Makes room for `count` elements without further rehashing.
+    void reserve(size_type count)
+    {
+        std::size_t new_capacity{ctrl_group::width};
+        while (max_load(new_capacity) < count) {
+            new_capacity *= 2;
+        }
+        if (new_capacity > capacity_) {
+            rehash(new_capacity);
+        }
+    }
+
+    iterator find(const key_type& key)
+    {
+        const std::size_t i{find_index(key, hash_(key))};
+        return i == npos ? end() : iterator_at(i);
+    }
+    const_iterator find(const key_type& key) const
+    {
+        return const_cast<raw_hash_table&>(*this).find(key);
+    }
+
+    bool contains(const key_type& key) const
+    {
+        return find_index(key, hash_(key)) != npos;
+    }
+
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        const auto i{static_cast<std::size_t>(pos.slot_ - slots_)};
+        erase_at(i);
+        iterator next{ctrl_ + i, slots_ + i};
+        next.skip_free();
+        return next;
+    }
+
+    iterator erase(iterator pos) noexcept
+        requires(!std::is_same_v<iterator, const_iterator>)
+    {
+        return erase(const_iterator{pos});
+    }
+
+    size_type erase(const key_type& key)
+    {
+        const std::size_t i{find_index(key, hash_(key))};
+        if (i == npos) {
+            return 0;
+        }
+        erase_at(i);
+        return 1;
+    }
+
+    void swap(raw_hash_table& other) noexcept
+    {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_, other.hash_);
+        swap(eq_, other.eq_);
+    }
+
+    friend void swap(raw_hash_table& lhs, raw_hash_table& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const raw_hash_table& lhs,
+                           const raw_hash_table& rhs)
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const value_type& v : lhs) {
+            const auto iter{rhs.find(Policy::key(v))};
+            if (iter == rhs.end() || !(*iter == v)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+   protected:
+    // Finds `key`, or else constructs an element from `args` in its place.
+    template <typename... Args>
+    std::pair<iterator, bool> find_or_emplace(const key_type& key,
+                                              Args&&... args)
+    {
+        const std::size_t hash{hash_(key)};
+        std::size_t i{find_index(key, hash)};
+        if (i != npos) {
+            return {iterator_at(i), false};
+        }
+        i = find_free_slot(hash);
+        if (growth_left_ == 0 && ctrl_[i] == ctrl_empty) {
+            grow();
+            i = find_free_slot(hash);
+        }
+        std::construct_at(slots_ + i, std::forward<Args>(args)...);
+        set_full(i, hash);
+        return {iterator_at(i), true};
+    }
+
+   private:
+    static constexpr std::size_t npos{~std::size_t{0}};
+
+    // Tables are at most 7/8 full, so every probe sequence reaches an empty
+    // slot.  Deleted slots count towards the load until the next rehash.
+    static constexpr std::size_t max_load(std::size_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    // The top bits choose the group where probing starts, and the low 7 bits
+    // go in the control byte, so the two are independent.
+    static constexpr std::size_t h1(std::size_t hash) noexcept
+    {
+        return hash >> 7;
+    }
+    static constexpr ctrl_t h2(std::size_t hash) noexcept
+    {
+        return static_cast<ctrl_t>(hash & 0x7f);
+    }
+
+    // Visits the groups in the order start, start+1, start+3, start+6, ...
+    // which covers every group when the number of groups is a power of two.
+    struct probe_seq {
+        std::size_t mask;
+        std::size_t offset;
+        std::size_t stride{0};
+
+        probe_seq(std::size_t hash, std::size_t capacity) noexcept
+            : mask{capacity - 1},
+              offset{(h1(hash) * ctrl_group::width) & mask}
+        {
+        }
+
+        void next() noexcept
+        {
+            stride += ctrl_group::width;
+            offset = (offset + stride) & mask;
+        }
+    };
+
+    iterator iterator_at(std::size_t i) noexcept
+    {
+        return {ctrl_ + i, slots_ + i};
+    }
+
+    std::size_t find_index(const key_type& key, std::size_t hash) const
+    {
+        if (capacity_ == 0) {
+            return npos;
+        }
+        const ctrl_t tag{h2(hash)};
+        for (probe_seq seq{hash, capacity_};; seq.next()) {
+            const ctrl_group group{ctrl_ + seq.offset};
+            for (std::uint32_t m{group.match(tag)}; m != 0; m &= m - 1) {
+                const std::size_t i{
+                    seq.offset + static_cast<std::size_t>(std::countr_zero(m))};
+                if (eq_(Policy::key(slots_[i]), key)) {
+                    return i;
+                }
+            }
+            if (group.match_empty() != 0) {
+                return npos;
+            }
+        }
+    }
+
+    // First empty or deleted slot in the probe sequence for `hash`.
+    std::size_t find_free_slot(std::size_t hash)
+    {
+        if (capacity_ == 0) {
+            grow();
+        }
+        for (probe_seq seq{hash, capacity_};; seq.next()) {
+            const std::uint32_t m{ctrl_group{ctrl_ + seq.offset}.match_free()};
+            if (m != 0) {
+                return seq.offset +
+                       static_cast<std::size_t>(std::countr_zero(m));
+            }
+        }
+    }
+
+    void set_full(std::size_t i, std::size_t hash) noexcept
+    {
+        if (ctrl_[i] == ctrl_empty) {
+            growth_left_--;
+        }
+        ctrl_[i] = h2(hash);
+        size_++;
+    }
+
+    void erase_at(std::size_t i) noexcept
+    {
+        std::destroy_at(slots_ + i);
+        size_--;
+        // A probe only continues past a group with no empty slots.  If this
+        // group still has one, nothing can have probed past it, so the slot
+        // can be emptied rather than left as a tombstone.
+        const ctrl_group group{ctrl_ + (i & ~(ctrl_group::width - 1))};
+        if (group.match_empty() != 0) {
+            ctrl_[i] = ctrl_empty;
+            growth_left_++;
+        }
+        else {
+            ctrl_[i] = ctrl_deleted;
+        }
+    }
+
+    // Doubles the capacity, unless enough of the load is tombstones that
+    // rehashing at the same size frees up plenty of room.
+    void grow()
+    {
+        if (capacity_ == 0) {
+            rehash(ctrl_group::width);
+        }
+        else if (size_ <= max_load(capacity_) / 2) {
+            rehash(capacity_);
+        }
+        else {
+            rehash(capacity_ * 2);
+        }
+    }
+
+    void rehash(std::size_t new_capacity)
+    {
+        raw_hash_table fresh;
+        fresh.hash_ = hash_;
+        fresh.eq_ = eq_;
+        // One extra control byte for the sentinel.
+        fresh.ctrl_ = new ctrl_t[new_capacity + 1];
+        std::memset(fresh.ctrl_, static_cast<unsigned char>(ctrl_empty),
+                    new_capacity);
+        fresh.ctrl_[new_capacity] = ctrl_sentinel;
+        fresh.slots_ = std::allocator<value_type>{}.allocate(new_capacity);
+        fresh.capacity_ = new_capacity;
+        fresh.growth_left_ = max_load(new_capacity);
+
+        for (std::size_t i{0}; i < capacity_; i++) {
+            if (ctrl_[i] >= 0) {
+                const std::size_t hash{hash_(Policy::key(slots_[i]))};
+                const std::size_t j{fresh.find_free_slot(hash)};
+                std::construct_at(fresh.slots_ + j, std::move(slots_[i]));
+                fresh.set_full(j, hash);
+            }
+        }
+        swap(fresh);
+    }
+
+    void destroy_elements() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (std::size_t i{0}; i < capacity_; i++) {
+                if (ctrl_[i] >= 0) {
+                    std::destroy_at(slots_ + i);
+                }
+            }
+        }
+    }
+
+    void destroy() noexcept
+    {
+        if (capacity_ == 0) {
+            return;
+        }
+        destroy_elements();
+        std::allocator<value_type>{}.deallocate(slots_, capacity_);
+        delete[] ctrl_;
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    ctrl_t* ctrl_{nullptr};
+    value_type* slots_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t size_{0};
+    std::size_t growth_left_{0};
+    [[no_unique_address]] Hash hash_{};
+    [[no_unique_address]] Eq eq_{};
+};
+
+template <typename Key>
+struct set_policy {
+    using key_type = Key;
+    using value_type = Key;
+    static constexpr bool constant_iterators{true};
+
+    static const Key& key(const value_type& v) noexcept { return v; }
+};
+
+template <typename Key, typename Value>
+struct map_policy {
+    using key_type = Key;
+    using value_type = std::pair<const Key, Value>;
+    static constexpr bool constant_iterators{false};
+
+    static const Key& key(const value_type& v) noexcept { return v.first; }
+};
+
+}  // namespace detail
+
+/// @brief Open-addressing hash set; see the top of aoc_flat_hash.hpp.
+template <typename Key,
+          typename Hash = hash<Key>,
+          typename Eq = std::equal_to<>>
+class flat_hash_set
+    : public detail::raw_hash_table<detail::set_policy<Key>, Hash, Eq> {
+    using base = detail::raw_hash_table<detail::set_policy<Key>, Hash, Eq>;
+
+   public:
+    using typename base::iterator;
+    using typename base::value_type;
+
+    flat_hash_set() = default;
+
+    template <typename InputIt>
+    flat_hash_set(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
+
+    flat_hash_set(std::initializer_list<value_type> values)
+    {
+        insert(values.begin(), values.end());
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return this->find_or_emplace(value, value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return this->find_or_emplace(value, std::move(value));
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+};
+
+/// @brief Open-addressing hash map; see the top of aoc_flat_hash.hpp.
+/// Elements are `std::pair<const Key, Value>` as in std::unordered_map.
+template <typename Key,
+          typename Value,
+          typename Hash = hash<Key>,
+          typename Eq = std::equal_to<>>
+class flat_hash_map
+    : public detail::raw_hash_table<detail::map_policy<Key, Value>, Hash, Eq> {
+    using base =
+        detail::raw_hash_table<detail::map_policy<Key, Value>, Hash, Eq>;
+
+   public:
+    using typename base::const_iterator;
+    using typename base::iterator;
+    using typename base::key_type;
+    using typename base::value_type;
+    using mapped_type = Value;
+
+    flat_hash_map() = default;
+
+    template <typename InputIt>
+    flat_hash_map(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> values)
+    {
+        insert(values.begin(), values.end());
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    {
+        return this->find_or_emplace(
+            key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+    {
+        return this->find_or_emplace(
+            key, std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return this->find_or_emplace(value.first, value);
+    }
+
+    // Also takes pairs of other types which convert to `value_type`.
+    template <typename Pair>
+        requires std::is_constructible_v<value_type, Pair&&>
+    std::pair<iterator, bool> insert(Pair&& value)
+    {
+        return this->find_or_emplace(value.first, std::forward<Pair>(value));
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return this->find_or_emplace(value.first, std::move(value));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& mapped)
+    {
+        auto result{try_emplace(key, std::forward<M>(mapped))};
+        if (!result.second) {
+            result.first->second = std::forward<M>(mapped);
+        }
+        return result;
+    }
+
+    Value& operator[](const key_type& key)
+    {
+        return try_emplace(key).first->second;
+    }
+    Value& operator[](key_type&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    Value& at(const key_type& key)
+    {
+        const auto iter{this->find(key)};
+        if (iter == this->end()) {
+            throw std::out_of_range("flat_hash_map::at: key not found");
+        }
+        return iter->second;
+    }
+
+    const Value& at(const key_type& key) const
+    {
+        return const_cast<flat_hash_map&>(*this).at(key);
+    }
+};
+
+}  // namespace aoc
+
+#endif  // AOC_FLAT_HASH_HPP
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_GENERATOR_HPP
+#define AOC_GENERATOR_HPP
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace aoc {
+
+namespace detail {
+
+// Free lists of coroutine frames, by size rounded up to `granularity`.  Each
+// coroutine function has a fixed frame size, so a generator which is called
+// over and over reuses the same few blocks instead of going to the heap each
+// time.  Frames too large to pool are allocated normally.
+class frame_pool {
+   public:
+    static constexpr std::size_t granularity{64};
+    static constexpr std::size_t max_pooled_size{4096};
+
+    frame_pool() = default;
+    frame_pool(const frame_pool&) = delete;
+    frame_pool& operator=(const frame_pool&) = delete;
+
+    ~frame_pool()
+    {
+        for (free_block* head : free_lists_) {
+            while (head) {
+                free_block* next{head->next};
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    void* allocate(std::size_t size)
+    {
+        if (size > max_pooled_size) {
+            return ::operator new(size);
+        }
+        free_block*& head{free_lists_[size_class(size)]};
+        if (head) {
+            free_block* block{head};
+            head = block->next;
+            return block;
+        }
+        return ::operator new(rounded_size(size));
+    }
+
+    void deallocate(void* p, std::size_t size) noexcept
+    {
+        if (size > max_pooled_size) {
+            ::operator delete(p);
+            return;
+        }
+        free_block*& head{free_lists_[size_class(size)]};
+        head = ::new (p) free_block{head};
+    }
+
+   private:
+    struct free_block {
+        free_block* next;
+    };
+
+    std::array<free_block*, max_pooled_size / granularity> free_lists_{};
+
+    static constexpr std::size_t size_class(std::size_t size) noexcept
+    {
+        return size == 0 ? 0 : (size - 1) / granularity;
+    }
+
+    static constexpr std::size_t rounded_size(std::size_t size) noexcept
+    {
+        return (size_class(size) + 1) * granularity;
+    }
+};
+
+// A frame goes back to the pool of whichever thread destroys its generator.
+inline frame_pool& local_frame_pool()
+{
+    thread_local frame_pool pool;
+    return pool;
+}
+
+}  // namespace detail
+
+// Coroutine generator for hot loops.  Compared with `Generator` in
+// coro_generator.hpp:
+// - Coroutine frames come from a thread-local pool rather than the heap.
+// - `co_yield` stores only the address of the yielded object, which stays
+//   alive while the coroutine is suspended, so nothing is copied.  A
+//   generator<T> yields `const T&`; a generator<T&> yields `T&`.
+// - It is an input range with a default-constructible iterator, so a generator
+//   held in a variable can be piped into range-v3 (or std) views.
+template <typename T>
+class generator {
+   public:
+    using value_type = std::remove_cvref_t<T>;
+    using reference =
+        std::conditional_t<std::is_reference_v<T>, T, const value_type&>;
+    using pointer = std::add_pointer_t<reference>;
+
+    struct promise_type {
+        pointer value{nullptr};
+
+        static void* operator new(std::size_t size)
+        {
+            return detail::local_frame_pool().allocate(size);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            detail::local_frame_pool().deallocate(p, size);
+        }
+
+        generator get_return_object() noexcept
+        {
+            return generator{handle::from_promise(*this)};
+        }
+        static std::suspend_always initial_suspend() noexcept { return {}; }
+        static std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(
+            std::remove_reference_t<reference>& v) noexcept
+        {
+            value = std::addressof(v);
+            return {};
+        }
+
+        // A temporary lives until the end of the `co_yield` expression, which
+        // is after the coroutine resumes.
+        std::suspend_always yield_value(
+            std::remove_reference_t<reference>&& v) noexcept
+        {
+            value = std::addressof(v);
+            return {};
+        }
+
+        // Disallow co_await in generator coroutines.
+        void await_transform() = delete;
+        void return_void() noexcept {}
+        [[noreturn]] static void unhandled_exception() { throw; }
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+       public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = generator::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = generator::reference;
+
+        iterator() = default;
+        explicit iterator(handle coroutine) noexcept : coroutine_{coroutine} {}
+
+        iterator& operator++()
+        {
+            coroutine_.resume();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        reference operator*() const noexcept
+        {
+            return static_cast<reference>(*coroutine_.promise().value);
+        }
+        pointer operator->() const noexcept
+        {
+            return coroutine_.promise().value;
+        }
+
+        friend bool operator==(const iterator& iter,
+                               std::default_sentinel_t) noexcept
+        {
+            return !iter.coroutine_ || iter.coroutine_.done();
+        }
+
+       private:
+        handle coroutine_;
+    };
+
+    generator() = default;
+    explicit generator(handle coroutine) noexcept : coroutine_{coroutine} {}
+
+    generator(const generator&) = delete;
+    generator& operator=(const generator&) = delete;
+
+    generator(generator&& other) noexcept
+        : coroutine_{std::exchange(other.coroutine_, {})}
+    {
+    }
+
+    generator& operator=(generator&& other) noexcept
+    {
+        if (this != &other) {
+            if (coroutine_) {
+                coroutine_.destroy();
+            }
+            coroutine_ = std::exchange(other.coroutine_, {});
+        }
+        return *this;
+    }
+
+    ~generator()
+    {
+        if (coroutine_) {
+            coroutine_.destroy();
+        }
+    }
+
+    // Starts the coroutine, so call it only once.
+    iterator begin()
+    {
+        if (coroutine_) {
+            coroutine_.resume();
+        }
+        return iterator{coroutine_};
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+   private:
+    handle coroutine_;
+};
+
+}  // namespace aoc
+
+#endif  // AOC_GENERATOR_HPP
@@ -8,13 +8,18 @@
 #ifndef AOC_GRAPH_HPP
 #define AOC_GRAPH_HPP
 
-#include <coro_generator.hpp>
+#include <aoc_generator.hpp>
 
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <iterator>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace aoc {
@@ -103,30 +108,33 @@ template <typename Map, typename Key>
 /// search.
 /// @param destination The destination `Vertex` to search for,
 /// if any.
+/// @param resource Memory resource for the search's bookkeeping, such as
+/// `aoc::arena_resource()`.
 template <typename Vertex, typename Adjacencies>
 [[nodiscard]] std::vector<Vertex> bfs_generic(
     Adjacencies&& adj,
     const Vertex& source,
-    const std::optional<Vertex>& destination)
+    const std::optional<Vertex>& destination,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
     enum class graph_color { white, gray, black };
     using distance = std::uint_fast32_t;
     // const distance
     // infinity_value{std::numeric_limits<distance>::max()};
 
-    using queue = std::queue<Vertex>;
+    using queue = std::queue<Vertex, std::pmr::deque<Vertex>>;
 
-    std::map<Vertex, graph_color> colors;
+    std::pmr::map<Vertex, graph_color> colors{resource};
 
     // "d" in the CLRS version.  If a vertex is missing from
     // this map, that's equivalent to being "infinity" in the
     // CLRS version.
-    std::map<Vertex, distance> distances;
+    std::pmr::map<Vertex, distance> distances{resource};
 
     // "pi" in CLRS version. If a vertex is missing from this
     // map, that's equivalent to being "NIL" in the CLRS
     // version.
-    std::map<Vertex, Vertex> predecessors;
+    std::pmr::map<Vertex, Vertex> predecessors{resource};
 
     // Here CLRS initializes the colors, distances and
     // predecessors for each vertex.  We don't know the vertexes
@@ -138,7 +146,7 @@ template <typename Vertex, typename Adjacencies>
     distances[source] = 0;
     // predecessors[source] = NIL
 
-    queue q;
+    queue q{std::pmr::deque<Vertex>{resource}};
     q.push(source);
 
     bool found_destination{false};
@@ -191,29 +199,33 @@ template <typename Vertex, typename Adjacencies>
 /// search.
 /// @param destination The destination `Vertex` to search for,
 /// if any.
+/// @param resource Memory resource for the search's bookkeeping, such as
+/// `aoc::arena_resource()`.
 template <typename Vertex, typename Adjacencies, typename AcceptFunc>
-[[nodiscard]] std::vector<Vertex> bfs_accept(Adjacencies&& adj,
-                                             const Vertex& source,
-                                             const AcceptFunc& accept)
+[[nodiscard]] std::vector<Vertex> bfs_accept(
+    Adjacencies&& adj,
+    const Vertex& source,
+    const AcceptFunc& accept,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
     enum class graph_color { white, gray, black };
     using distance = std::uint_fast32_t;
     // const distance
     // infinity_value{std::numeric_limits<distance>::max()};
 
-    using queue = std::queue<Vertex>;
+    using queue = std::queue<Vertex, std::pmr::deque<Vertex>>;
 
-    std::map<Vertex, graph_color> colors;
+    std::pmr::map<Vertex, graph_color> colors{resource};
 
     // "d" in the CLRS version.  If a vertex is missing from
     // this map, that's equivalent to being "infinity" in the
     // CLRS version.
-    std::map<Vertex, distance> distances;
+    std::pmr::map<Vertex, distance> distances{resource};
 
     // "pi" in CLRS version. If a vertex is missing from this
     // map, that's equivalent to being "NIL" in the CLRS
     // version.
-    std::map<Vertex, Vertex> predecessors;
+    std::pmr::map<Vertex, Vertex> predecessors{resource};
 
     // Here CLRS initializes the colors, distances and
     // predecessors for each vertex.  We don't know the vertexes
@@ -225,7 +237,7 @@ template <typename Vertex, typename Adjacencies, typename AcceptFunc>
     distances[source] = 0;
     // predecessors[source] = NIL
 
-    queue q;
+    queue q{std::pmr::deque<Vertex>{resource}};
     q.push(source);
 
     bool found_destination{false};
@@ -272,12 +284,15 @@ template <typename Vertex, typename Adjacencies, typename AcceptFunc>
 /// except finding the adjacent vertexes.
 /// @param source The source `Vertex` from which to begin the search.
 /// @param destination The destination `Vertex` to search for.
+/// @param resource Memory resource for the search's bookkeeping.
 template <typename Vertex, typename Adjacencies>
-[[nodiscard]] std::vector<Vertex> bfs_path(Adjacencies&& adj,
-                                           const Vertex& source,
-                                           const Vertex& destination)
+[[nodiscard]] std::vector<Vertex> bfs_path(
+    Adjacencies&& adj,
+    const Vertex& source,
+    const Vertex& destination,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
-    return bfs_generic(adj, source, {destination});
+    return bfs_generic(adj, source, {destination}, resource);
 }
 
 // TODO: bfs_tree, returning the discovered breadth-first tree instead of just
@@ -301,26 +316,28 @@ template <typename Vertex, typename Adjacencies>
 /// @param source The source `Vertex` from which to begin the search.
 /// @param destination The destination `Vertex` to search for, if any.
 /// @param depth_limit
+/// @param resource Memory resource for the search's bookkeeping.
 /// @return Path to destination, if any
 template <typename Vertex, typename Adjacencies>
 [[nodiscard]] std::vector<Vertex> dfs_single_source(
     Adjacencies&& adj,
     const Vertex& source,
     const std::optional<Vertex>& destination,
-    const int depth_limit = 0)
+    const int depth_limit = 0,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
     enum class graph_color { white, gray, black };
 
-    std::map<Vertex, graph_color> colors;
+    std::pmr::map<Vertex, graph_color> colors{resource};
 
     // "d" in the CLRS version.  If a vertex is missing from this map, that's
     // equivalent to being "infinity" in the CLRS version.
-    std::map<Vertex, std::uint64_t> distances;
+    std::pmr::map<Vertex, std::uint64_t> distances{resource};
 
     // "pi" in CLRS version. If a vertex is missing from this map, that's
     // equivalent to being "NIL" in the CLRS version.
-    std::map<Vertex, Vertex> predecessors;
-    std::map<Vertex, std::uint64_t> finish_times;
+    std::pmr::map<Vertex, Vertex> predecessors{resource};
+    std::pmr::map<Vertex, std::uint64_t> finish_times{resource};
 
     std::uint64_t time{0};  // "global" variable used for timestamping
 
@@ -367,12 +384,15 @@ template <typename Vertex, typename Adjacencies>
 }
 
 template <typename Vertex, typename Adjacencies>
-[[nodiscard]] std::vector<Vertex> dfs_path(Adjacencies&& adj,
-                                           const Vertex& source,
-                                           const Vertex& destination,
-                                           const int depth_limit = 0)
+[[nodiscard]] std::vector<Vertex> dfs_path(
+    Adjacencies&& adj,
+    const Vertex& source,
+    const Vertex& destination,
+    const int depth_limit = 0,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
-    return dfs_single_source(adj, source, {destination}, depth_limit);
+    return dfs_single_source(adj, source, {destination}, depth_limit,
+                             resource);
 }
 
 // Backtracking graph search
@@ -421,16 +441,41 @@ void backtrack(const BacktrackGraph& graph)
 template <typename BacktrackGraph>
 struct range_stack_elem {
     using vertex_type = typename BacktrackGraph::vertex_type;
+    using range_type =
+        decltype(static_cast<BacktrackGraph*>(nullptr)->adjacencies({}));
+
     range_stack_elem(const BacktrackGraph& g, const vertex_type& v)
         : range{g.adjacencies(v)}, iter{range.begin()}
     {
     }
-    decltype(static_cast<BacktrackGraph*>(nullptr)->adjacencies({})) range;
+
+    // The range may keep its elements inside itself (e.g. small_vector), so
+    // `iter` is rebuilt from its position rather than moved.
+    range_stack_elem(range_stack_elem&& other) noexcept(
+        std::is_nothrow_move_constructible_v<range_type>)
+        : range_stack_elem{std::move(other.range), other.position()}
+    {
+    }
+
+    range_stack_elem& operator=(range_stack_elem&&) = delete;
+
+    range_type range;
     decltype(range.begin()) iter;
+
+   private:
+    range_stack_elem(range_type&& r, std::ptrdiff_t position)
+        : range{std::move(r)}, iter{std::next(range.begin(), position)}
+    {
+    }
+
+    std::ptrdiff_t position()
+    {
+        return static_cast<std::ptrdiff_t>(std::distance(range.begin(), iter));
+    }
 };
 
 template <typename BacktrackGraph>
-Generator<typename BacktrackGraph::candidate_type> backtrack_coro(
+generator<typename BacktrackGraph::candidate_type> backtrack_coro(
     BacktrackGraph& graph)
 {
     auto candidate{graph.root()};
@@ -468,24 +513,34 @@ template <typename DijkstraGraph>
 struct dijkstra_out {
     using vertex_type = typename DijkstraGraph::vertex_type;
     using cost_type = typename DijkstraGraph::cost_type;
-    std::map<vertex_type, cost_type> dist;
-    std::map<vertex_type, vertex_type> prev;
+    std::pmr::map<vertex_type, cost_type> dist;
+    std::pmr::map<vertex_type, vertex_type> prev;
     std::optional<vertex_type> end;
 };
 
+/// @brief Dijkstra's algorithm, stopping at the first vertex accepted by the
+/// graph.  The result's maps, and the search's queue, are allocated from
+/// `resource`.
 template <typename DijkstraGraph>
-dijkstra_out<DijkstraGraph> dijkstra(const DijkstraGraph& graph)
+dijkstra_out<DijkstraGraph> dijkstra(
+    const DijkstraGraph& graph,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
     using queue_entry = typename DijkstraGraph::queue_entry;
     using vertex_type = typename DijkstraGraph::vertex_type;
     const vertex_type start = graph.root();
 
-    dijkstra_out<DijkstraGraph> out;
+    using cost_type = typename DijkstraGraph::cost_type;
+    dijkstra_out<DijkstraGraph> out{
+        std::pmr::map<vertex_type, cost_type>{resource},
+        std::pmr::map<vertex_type, vertex_type>{resource}, std::nullopt};
     out.dist.emplace(start, 0);
 
-    using queue_t = std::priority_queue<queue_entry, std::vector<queue_entry>,
-                                        std::greater<queue_entry>>;
-    queue_t q;
+    using queue_t =
+        std::priority_queue<queue_entry, std::pmr::vector<queue_entry>,
+                            std::greater<queue_entry>>;
+    queue_t q{std::greater<queue_entry>{},
+              std::pmr::vector<queue_entry>{resource}};
     q.push({start, 0});
 
     while (!q.empty()) {
@@ -8,15 +8,22 @@
 #ifndef AOC_GRID_HPP
 #define AOC_GRID_HPP
 
+#include "aoc_hash.hpp"
 #include "aoc_range.hpp"
+#include "aoc_simd.hpp"
 #include "aoc_vec.hpp"
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <compare>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <span>
 #include <tuple>
+#include <type_traits>
 
 namespace aoc {
 
@@ -283,44 +290,61 @@ class heap_grid : public grid_adapter<heap_data<Value, Width * Height>, Width> {
     heap_data<Value, Width * Height> data_;
 };
 
+// Storage for a dynamic_grid, allocated from a memory resource so that a
+// solution's scratch grids can live in its arena.  As with the std::pmr
+// containers, a copy allocates from the default resource unless it's given
+// one, so it can outlive the arena the original came from.
 template <typename Value>
 class dynamic_heap_data {
    public:
-    dynamic_heap_data(std::size_t size)
-        : data_{std::make_unique<Value[]>(size)}, size_{size}
+    using allocator_type = std::pmr::polymorphic_allocator<Value>;
+
+    dynamic_heap_data(std::size_t size, allocator_type alloc = {})
+        : alloc_{alloc}, data_{alloc_.allocate(size)}, size_{size}
     {
-        r::fill(std::span{data_.get(), size_}, Value{0});
+        std::uninitialized_fill_n(data_, size_, Value{0});
     }
 
-    // dynamic_heap_data(dynamic_heap_data&& other) noexcept
-    //     : data_{std::move(other.data_)}, size_{other.size_}
-    // {
-    // }
-
     dynamic_heap_data(const dynamic_heap_data& other) noexcept
-        : data_{std::make_unique<Value[]>(other.size_)}, size_{other.size_}
+        : dynamic_heap_data{other, allocator_type{}}
     {
-        std::copy(other.data_.get(), other.data_.get() + size_, data_.get());
     }
 
-    // dynamic_heap_data& operator=(dynamic_heap_data&& other) noexcept
-    // {
-    //     data_ = std::move(other.data_);
-    //     size_ = other.size_;
-    //     return *this;
-    // }
+    dynamic_heap_data(const dynamic_heap_data& other,
+                      allocator_type alloc) noexcept
+        : alloc_{alloc},
+          data_{alloc_.allocate(other.size_)},
+          size_{other.size_}
+    {
+        std::uninitialized_copy_n(other.data_, size_, data_);
+    }
 
     dynamic_heap_data& operator=(const dynamic_heap_data& other) noexcept
     {
-        data_ = std::make_unique<Value[]>(other.size_);
+        if (this == &other) {
+            return *this;
+        }
+        if (size_ == other.size_) {
+            std::copy_n(other.data_, size_, data_);
+            return *this;
+        }
+        release();
+        data_ = alloc_.allocate(other.size_);
         size_ = other.size_;
-        std::copy(other.data_.get(), other.data_.get() + size_, data_.get());
+        std::uninitialized_copy_n(other.data_, size_, data_);
         return *this;
     }
 
-    auto begin() const noexcept { return data_.get(); }
+    ~dynamic_heap_data() noexcept { release(); }
+
+    auto begin() const noexcept { return data_; }
     auto end() const noexcept { return begin() + size_; }
 
+    std::pmr::memory_resource* resource() const noexcept
+    {
+        return alloc_.resource();
+    }
+
     friend auto operator<=>(const dynamic_heap_data& lhs,
                             const dynamic_heap_data& rhs) noexcept
     {
@@ -335,25 +359,47 @@ class dynamic_heap_data {
     }
 
    private:
-    std::unique_ptr<Value[]> data_;
+    allocator_type alloc_;
+    Value* data_;
     std::size_t size_;
+
+    void release() noexcept
+    {
+        std::destroy_n(data_, size_);
+        alloc_.deallocate(data_, size_);
+    }
 };
 
 template <typename Value>
 class dynamic_grid : public dynamic_grid_adapter<dynamic_heap_data<Value>> {
    public:
     dynamic_grid(int width, int height) noexcept
+        : dynamic_grid{width, height, std::pmr::get_default_resource()}
+    {
+    }
+
+    // Grid whose storage comes from `resource`.  Copies use the default
+    // resource unless they're given one.
+    dynamic_grid(int width,
+                 int height,
+                 std::pmr::memory_resource* resource) noexcept
         // FIXME: passign `data_` by reference before it's initialized is
         // undefined behavior
         : dynamic_grid_adapter<dynamic_heap_data<Value>>{data_, width, height},
-          data_{static_cast<std::size_t>(width * height)}
+          data_{static_cast<std::size_t>(width * height), resource}
     {
     }
 
     dynamic_grid(const dynamic_grid& other) noexcept
+        : dynamic_grid{other, std::pmr::get_default_resource()}
+    {
+    }
+
+    dynamic_grid(const dynamic_grid& other,
+                 std::pmr::memory_resource* resource) noexcept
         : dynamic_grid_adapter<dynamic_heap_data<Value>>{data_, other.width(),
                                                          other.height()},
-          data_{other.data_}
+          data_{other.data_, resource}
     {
     }
 
@@ -388,6 +434,210 @@ class dynamic_grid : public dynamic_grid_adapter<dynamic_heap_data<Value>> {
     dynamic_heap_data<Value> data_;
 };
 
+// Row and column reductions over contiguous grid memory
+//
+// The `row()`/`col()` views above are convenient but iterate one element at a
+// time, and `col()` strides across the whole grid.  The functions below work on
+// raw row storage instead, so byte-sized grids go through the vectorized
+// kernels in aoc_simd.hpp.  For column passes, make one `transposed()` copy and
+// use the row functions on it.
+
+// Contiguous span of row `y`.  Requires a grid backed by contiguous storage
+// (static_grid, heap_grid, dynamic_grid).
+template <typename Grid>
+auto row_span(Grid& grid, int y) noexcept
+{
+    const auto width{static_cast<std::size_t>(grid.width())};
+    auto* const base{&*r::begin(grid.data())};
+    return std::span{base + static_cast<std::size_t>(y) * width, width};
+}
+
+namespace detail {
+template <typename Span>
+std::span<const char> as_chars(Span s) noexcept
+{
+    return {reinterpret_cast<const char*>(s.data()), s.size()};
+}
+
+template <typename Value>
+constexpr bool simd_eligible{sizeof(Value) == 1 &&
+                             std::is_trivially_copyable_v<Value>};
+
+template <typename Value>
+char to_char(Value v) noexcept
+{
+    return std::bit_cast<char>(v);
+}
+}  // namespace detail
+
+// Number of cells in row `y` equal to `value`.
+template <typename Grid, typename Value>
+std::size_t row_count(const Grid& grid, int y, const Value& value) noexcept
+{
+    const auto row{row_span(grid, y)};
+    using cell_type = std::remove_cvref_t<decltype(row[0])>;
+    if constexpr (detail::simd_eligible<cell_type>) {
+        return count_equal(detail::as_chars(row),
+                           detail::to_char(static_cast<cell_type>(value)));
+    }
+    else {
+        return static_cast<std::size_t>(std::count(row.begin(), row.end(), value));
+    }
+}
+
+// True if every cell in row `y` is equal to `value`.
+template <typename Grid, typename Value>
+bool row_all_of(const Grid& grid, int y, const Value& value) noexcept
+{
+    const auto row{row_span(grid, y)};
+    using cell_type = std::remove_cvref_t<decltype(row[0])>;
+    if constexpr (detail::simd_eligible<cell_type>) {
+        return all_equal(detail::as_chars(row),
+                         detail::to_char(static_cast<cell_type>(value)));
+    }
+    else {
+        return std::all_of(row.begin(), row.end(),
+                           [&](const auto& v) { return v == value; });
+    }
+}
+
+// True if any cell in row `y` is equal to `value`.
+template <typename Grid, typename Value>
+bool row_any_of(const Grid& grid, int y, const Value& value) noexcept
+{
+    const auto row{row_span(grid, y)};
+    using cell_type = std::remove_cvref_t<decltype(row[0])>;
+    if constexpr (detail::simd_eligible<cell_type>) {
+        return any_equal(detail::as_chars(row),
+                         detail::to_char(static_cast<cell_type>(value)));
+    }
+    else {
+        return std::find(row.begin(), row.end(), value) != row.end();
+    }
+}
+
+// Number of columns at which rows `y1` and `y2` differ.
+template <typename Grid>
+std::size_t row_difference(const Grid& grid, int y1, int y2) noexcept
+{
+    const auto row1{row_span(grid, y1)};
+    const auto row2{row_span(grid, y2)};
+    using cell_type = std::remove_cvref_t<decltype(row1[0])>;
+    if constexpr (detail::simd_eligible<cell_type>) {
+        return count_mismatches(detail::as_chars(row1), detail::as_chars(row2));
+    }
+    else {
+        std::size_t count{0};
+        for (std::size_t x{0}; x < row1.size(); x++) {
+            count += (row1[x] != row2[x]) ? 1u : 0u;
+        }
+        return count;
+    }
+}
+
+// True if rows `y1` and `y2` are identical.
+template <typename Grid>
+bool rows_equal(const Grid& grid, int y1, int y2) noexcept
+{
+    const auto row1{row_span(grid, y1)};
+    const auto row2{row_span(grid, y2)};
+    return std::equal(row1.begin(), row1.end(), row2.begin(), row2.end());
+}
+
+// Contiguous span of every cell in the grid, in row-major order.
+template <typename Grid>
+auto grid_span(Grid& grid) noexcept
+{
+    return std::span{&*r::begin(grid.data()),
+                     static_cast<std::size_t>(grid.width()) *
+                         static_cast<std::size_t>(grid.height())};
+}
+
+// Number of cells in the whole grid equal to `value`.
+template <typename Grid, typename Value>
+std::size_t grid_count(const Grid& grid, const Value& value) noexcept
+{
+    const auto all{grid_span(grid)};
+    using cell_type = std::remove_cvref_t<decltype(all[0])>;
+    if constexpr (detail::simd_eligible<cell_type>) {
+        return count_equal(detail::as_chars(all),
+                           detail::to_char(static_cast<cell_type>(value)));
+    }
+    else {
+        return static_cast<std::size_t>(std::count(all.begin(), all.end(), value));
+    }
+}
+
+// 128-bit hash of the contents and width of a grid.  Two grids with the same
+// fingerprint can be assumed to be equal, so a fingerprint can be stored in
+// place of a copy of the grid, such as for cycle detection.
+template <typename Grid>
+fingerprint grid_fingerprint(const Grid& grid) noexcept
+{
+    return hash_span(grid_span(grid), static_cast<std::uint64_t>(grid.width()));
+}
+
+// Hash of the contents and dimensions of a grid, for keying hash tables by
+// grid.  Grids with contiguous storage are hashed 16 bytes at a time through
+// `grid_fingerprint`; views such as subgrids go a cell at a time.  The two give
+// different values for the same contents, so keep one kind per table.
+struct grid_hash {
+    template <typename Grid>
+    std::size_t operator()(const Grid& grid) const noexcept
+    {
+        using iterator_type = r::iterator_t<decltype(grid.data())>;
+        if constexpr (std::contiguous_iterator<iterator_type>) {
+            return static_cast<std::size_t>(grid_fingerprint(grid).low);
+        }
+        else {
+            // FNV-1a over the cells, then a finalizer.
+            std::uint64_t h{detail::hash_combine(
+                static_cast<std::uint64_t>(grid.width()),
+                static_cast<std::uint64_t>(grid.height()))};
+            for (const auto& cell : grid.data()) {
+                using cell_type = std::remove_cvref_t<decltype(cell)>;
+                h = (h ^ static_cast<std::uint64_t>(
+                             std::hash<cell_type>{}(cell))) *
+                    0x100000001b3ULL;
+            }
+            return static_cast<std::size_t>(detail::fmix64(h));
+        }
+    }
+};
+
+// Return a copy of `grid` with rows and columns swapped, so that column `x` of
+// `grid` is row `x` of the result.  The copy is done in square tiles so that
+// both the reads and the writes stay within a few cache lines at a time.
+template <typename Grid>
+auto transposed(const Grid& grid)
+{
+    using cell_type = std::remove_cvref_t<decltype(row_span(grid, 0)[0])>;
+    const int width{grid.width()};
+    const int height{grid.height()};
+    dynamic_grid<cell_type> out{height, width};
+
+    const auto* const in{&*r::begin(grid.data())};
+    auto* const dest{&*r::begin(out.data())};
+    const auto index{[](int row, int col, int stride) {
+        return static_cast<std::size_t>(row) * static_cast<std::size_t>(stride) +
+               static_cast<std::size_t>(col);
+    }};
+
+    constexpr int tile{32};
+    for (int y0{0}; y0 < height; y0 += tile) {
+        const int y1{std::min(y0 + tile, height)};
+        for (int x0{0}; x0 < width; x0 += tile) {
+            const int x1{std::min(x0 + tile, width)};
+            for (int y{y0}; y < y1; y++) {
+                for (int x{x0}; x < x1; x++) {
+                    dest[index(x, y, height)] = in[index(y, x, width)];
+                }
+            }
+        }
+    }
+    return out;
+}
+
 }  // namespace aoc
 
 #endif  // AOC_GRID_HPP
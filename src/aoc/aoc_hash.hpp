@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_HASH_HPP
+#define AOC_HASH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+
+namespace aoc {
+
+// 128-bit hash of some state, large enough that it can stand in for the state
+// itself when checking whether a state has been seen before.
+struct fingerprint {
+    std::uint64_t low{};
+    std::uint64_t high{};
+
+    friend auto operator<=>(const fingerprint&,
+                            const fingerprint&) noexcept = default;
+};
+
+namespace detail {
+constexpr std::uint64_t fmix64(std::uint64_t k) noexcept
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// Boost's hash_combine pattern, with a full finalizer so that the result is
+// well mixed even when the inputs are small integers.
+constexpr std::uint64_t hash_combine(std::uint64_t seed,
+                                     std::uint64_t value) noexcept
+{
+    return fmix64(seed ^
+                  (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+inline std::uint64_t load64(const std::byte* p) noexcept
+{
+    std::uint64_t out;
+    std::memcpy(&out, p, sizeof(out));
+    return out;
+}
+}  // namespace detail
+
+// Default hasher for the tables in aoc_flat_hash.hpp.  Those tables take the
+// probe position and the tag from different bits of the hash, so every bit has
+// to depend on the whole key; `std::hash` is the identity for integers on the
+// common standard libraries, so its result is mixed once more.
+template <typename T>
+struct hash {
+    std::size_t operator()(const T& v) const
+        noexcept(noexcept(std::hash<T>{}(v)))
+    {
+        return static_cast<std::size_t>(
+            detail::fmix64(static_cast<std::uint64_t>(std::hash<T>{}(v))));
+    }
+};
+
+// MurmurHash3_x64_128 by Austin Appleby (public domain), which digests 16 bytes
+// per step.
+inline fingerprint hash_bytes(std::span<const std::byte> bytes,
+                              std::uint64_t seed = 0) noexcept
+{
+    constexpr std::uint64_t c1{0x87c37b91114253d5ULL};
+    constexpr std::uint64_t c2{0x4cf5ad432745937fULL};
+
+    std::uint64_t h1{seed};
+    std::uint64_t h2{seed};
+
+    const std::size_t blocks{bytes.size() / 16};
+    const std::byte* data{bytes.data()};
+    for (std::size_t i{0}; i < blocks; i++) {
+        std::uint64_t k1{detail::load64(data + i * 16)};
+        std::uint64_t k2{detail::load64(data + i * 16 + 8)};
+
+        k1 *= c1;
+        k1 = std::rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+
+        h1 = std::rotl(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = std::rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+
+        h2 = std::rotl(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Remaining 0-15 bytes, little-endian as in the reference implementation.
+    const std::byte* tail{data + blocks * 16};
+    const std::size_t tail_size{bytes.size() & 15};
+    std::uint64_t k1{0};
+    std::uint64_t k2{0};
+    for (std::size_t i{tail_size}; i > 8; i--) {
+        k2 ^= std::uint64_t{std::to_integer<std::uint8_t>(tail[i - 1])}
+              << ((i - 9) * 8);
+    }
+    for (std::size_t i{std::min<std::size_t>(tail_size, 8)}; i > 0; i--) {
+        k1 ^= std::uint64_t{std::to_integer<std::uint8_t>(tail[i - 1])}
+              << ((i - 1) * 8);
+    }
+    if (tail_size > 8) {
+        k2 *= c2;
+        k2 = std::rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if (tail_size > 0) {
+        k1 *= c1;
+        k1 = std::rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= bytes.size();
+    h2 ^= bytes.size();
+    h1 += h2;
+    h2 += h1;
+    h1 = detail::fmix64(h1);
+    h2 = detail::fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    return {h1, h2};
+}
+
+// Fingerprint of a contiguous range of trivially-copyable objects, such as the
+// storage of a grid or one of its rows.
+template <typename T, std::size_t Extent>
+fingerprint hash_span(std::span<T, Extent> s, std::uint64_t seed = 0) noexcept
+{
+    return hash_bytes(std::as_bytes(s), seed);
+}
+
+}  // namespace aoc
+
+template <>
+struct std::hash<aoc::fingerprint> {
+    std::size_t operator()(const aoc::fingerprint& f) const noexcept
+    {
+        // The fingerprint is already well mixed, so either half will do.
+        return static_cast<std::size_t>(f.low);
+    }
+};
+
+#endif  // AOC_HASH_HPP
@@ -0,0 +1,347 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_INTERVAL_HPP
+#define AOC_INTERVAL_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+/// @brief Range of integers from `lo` (inclusive) to `hi` (exclusive).
+template <typename T>
+struct interval {
+    T lo{};
+    T hi{};
+
+    constexpr bool empty() const noexcept { return lo >= hi; }
+    constexpr T length() const noexcept
+    {
+        return empty() ? T{} : static_cast<T>(hi - lo);
+    }
+    constexpr bool contains(T x) const noexcept { return x >= lo && x < hi; }
+
+    friend constexpr auto operator<=>(const interval&,
+                                      const interval&) noexcept = default;
+};
+
+template <typename T>
+constexpr std::optional<interval<T>> intersection(const interval<T>& a,
+                                                  const interval<T>& b) noexcept
+{
+    const interval<T> out{std::max(a.lo, b.lo), std::min(a.hi, b.hi)};
+    if (out.empty()) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+/// @brief Set of integers stored as a sorted vector of disjoint intervals.
+///
+/// Adjacent and overlapping intervals are merged as they are inserted, so the
+/// stored intervals are always separated by at least one missing value.
+/// Lookups are binary searches; insertions and removals are a binary search
+/// plus a shift of the vector's tail.  To build a set from many intervals at
+/// once, `assign` sorts them and merges them in a single pass, reusing the
+/// set's existing storage.
+template <typename T>
+class interval_set {
+   public:
+    using interval_type = interval<T>;
+    using const_iterator = typename std::vector<interval_type>::const_iterator;
+
+    interval_set() = default;
+    interval_set(std::initializer_list<interval_type> intervals)
+    {
+        assign(intervals);
+    }
+
+    /// @brief Replace the contents of the set with the union of `intervals`.
+    template <typename Range>
+    void assign(const Range& intervals)
+    {
+        intervals_.clear();
+        for (const interval_type& iv : intervals) {
+            if (!iv.empty()) {
+                intervals_.push_back(iv);
+            }
+        }
+        std::sort(intervals_.begin(), intervals_.end());
+        if (intervals_.empty()) {
+            return;
+        }
+
+        auto out{intervals_.begin()};
+        for (auto iter{std::next(out)}; iter != intervals_.end(); ++iter) {
+            if (iter->lo <= out->hi) {
+                out->hi = std::max(out->hi, iter->hi);
+            }
+            else {
+                *++out = *iter;
+            }
+        }
+        intervals_.erase(std::next(out), intervals_.end());
+    }
+
+    void insert(interval_type iv)
+    {
+        if (iv.empty()) {
+            return;
+        }
+        // Every stored interval which overlaps or touches `iv`.
+        const auto first{
+            std::partition_point(intervals_.begin(), intervals_.end(),
+                                 [&](const auto& x) { return x.hi < iv.lo; })};
+        const auto last{std::partition_point(
+            first, intervals_.end(),
+            [&](const auto& x) { return x.lo <= iv.hi; })};
+        if (first == last) {
+            intervals_.insert(first, iv);
+            return;
+        }
+        first->lo = std::min(first->lo, iv.lo);
+        first->hi = std::max(std::prev(last)->hi, iv.hi);
+        intervals_.erase(std::next(first), last);
+    }
+
+    void erase(interval_type iv)
+    {
+        if (iv.empty()) {
+            return;
+        }
+        // Every stored interval which overlaps `iv`.
+        const auto first{
+            std::partition_point(intervals_.begin(), intervals_.end(),
+                                 [&](const auto& x) { return x.hi <= iv.lo; })};
+        const auto last{std::partition_point(
+            first, intervals_.end(),
+            [&](const auto& x) { return x.lo < iv.hi; })};
+        if (first == last) {
+            return;
+        }
+        const interval_type left{first->lo, iv.lo};
+        const interval_type right{iv.hi, std::prev(last)->hi};
+        auto iter{intervals_.erase(first, last)};
+        if (!right.empty()) {
+            iter = intervals_.insert(iter, right);
+        }
+        if (!left.empty()) {
+            intervals_.insert(iter, left);
+        }
+    }
+
+    void clear() noexcept { intervals_.clear(); }
+
+    /// @brief The stored interval containing `x`, or `end()` if none does.
+    const_iterator find(T x) const noexcept
+    {
+        const auto iter{
+            std::partition_point(intervals_.begin(), intervals_.end(),
+                                 [&](const auto& iv) { return iv.hi <= x; })};
+        if (iter != intervals_.end() && iter->contains(x)) {
+            return iter;
+        }
+        return intervals_.end();
+    }
+
+    bool contains(T x) const noexcept { return find(x) != intervals_.end(); }
+
+    /// @brief Number of values in the set.
+    T length() const noexcept
+    {
+        T out{};
+        for (const interval_type& iv : intervals_) {
+            out += iv.length();
+        }
+        return out;
+    }
+
+    bool empty() const noexcept { return intervals_.empty(); }
+    const_iterator begin() const noexcept { return intervals_.begin(); }
+    const_iterator end() const noexcept { return intervals_.end(); }
+    std::span<const interval_type> intervals() const noexcept
+    {
+        return intervals_;
+    }
+
+    friend bool operator==(const interval_set&,
+                           const interval_set&) noexcept = default;
+
+   private:
+    std::vector<interval_type> intervals_;
+};
+
+/// @brief Values within `within` which are not in `set`.
+template <typename T>
+interval_set<T> complement(const interval_set<T>& set, interval<T> within)
+{
+    std::vector<interval<T>> gaps;
+    T lo{within.lo};
+    for (const interval<T>& iv : set) {
+        if (iv.lo >= within.hi) {
+            break;
+        }
+        if (iv.lo > lo) {
+            gaps.push_back({lo, iv.lo});
+        }
+        lo = std::max(lo, iv.hi);
+    }
+    if (lo < within.hi) {
+        gaps.push_back({lo, within.hi});
+    }
+    interval_set<T> out;
+    out.assign(gaps);
+    return out;
+}
+
+/// @brief Values which are in both `a` and `b`.
+template <typename T>
+interval_set<T> intersection(const interval_set<T>& a, const interval_set<T>& b)
+{
+    std::vector<interval<T>> overlaps;
+    auto a_iter{a.begin()};
+    auto b_iter{b.begin()};
+    while (a_iter != a.end() && b_iter != b.end()) {
+        if (const auto overlap{intersection(*a_iter, *b_iter)}) {
+            overlaps.push_back(*overlap);
+        }
+        if (a_iter->hi < b_iter->hi) {
+            ++a_iter;
+        }
+        else {
+            ++b_iter;
+        }
+    }
+    interval_set<T> out;
+    out.assign(overlaps);
+    return out;
+}
+
+/// @brief Piecewise-constant function from integers to values of type `V`.
+///
+/// Stored as a sorted vector of breakpoints, each holding the value from its
+/// key up to the next breakpoint's key.  The first breakpoint is always at
+/// the lowest value of `T`, so every key has a value; neighbouring pieces with
+/// equal values are merged.
+template <typename T, typename V>
+class interval_map {
+   public:
+    using interval_type = interval<T>;
+    using breakpoint = std::pair<T, V>;
+
+    /// @brief Interval spanning every key.
+    static constexpr interval_type domain{std::numeric_limits<T>::lowest(),
+                                          std::numeric_limits<T>::max()};
+
+    explicit interval_map(V initial = {})
+        : breakpoints_{{domain.lo, std::move(initial)}}
+    {
+    }
+
+    const V& at(T key) const noexcept
+    {
+        return std::prev(upper_bound(key))->second;
+    }
+
+    /// @brief Set the value of every key within `iv` to `value`.
+    void assign(interval_type iv, V value)
+    {
+        if (iv.empty()) {
+            return;
+        }
+        V after{at(iv.hi)};
+        const auto first{std::partition_point(
+            breakpoints_.begin(), breakpoints_.end(),
+            [&](const breakpoint& b) { return b.first < iv.lo; })};
+        const auto last{upper_bound(iv.hi)};
+
+        const auto lo_index{
+            static_cast<std::size_t>(first - breakpoints_.begin())};
+        const bool merge_after{after == value};
+        const bool merge_before{lo_index > 0 &&
+                                breakpoints_[lo_index - 1].second == value};
+
+        auto iter{breakpoints_.erase(first, last)};
+        if (!merge_after) {
+            iter = breakpoints_.insert(iter, {iv.hi, std::move(after)});
+        }
+        if (!merge_before) {
+            breakpoints_.insert(iter, {iv.lo, std::move(value)});
+        }
+    }
+
+    /// @brief Call `func(piece, value)` for each piece of the map within
+    /// `within`, in order, with each piece clipped to `within`.
+    template <typename Func>
+    void for_each(interval_type within, Func func) const
+    {
+        if (within.empty()) {
+            return;
+        }
+        for (auto iter{std::prev(upper_bound(within.lo))};
+             iter != breakpoints_.end() && iter->first < within.hi; ++iter) {
+            const auto next{std::next(iter)};
+            const interval_type piece{
+                std::max(iter->first, within.lo),
+                next == breakpoints_.end() ? within.hi
+                                           : std::min(next->first, within.hi)};
+            func(piece, iter->second);
+        }
+    }
+
+    std::span<const breakpoint> breakpoints() const noexcept
+    {
+        return breakpoints_;
+    }
+
+    friend bool operator==(const interval_map&,
+                           const interval_map&) noexcept = default;
+
+   private:
+    std::vector<breakpoint> breakpoints_;
+
+    auto upper_bound(T key) const noexcept
+    {
+        return std::partition_point(
+            breakpoints_.begin(), breakpoints_.end(),
+            [&](const breakpoint& b) { return b.first <= key; });
+    }
+};
+
+/// @brief Compose two maps whose values are offsets added to their keys,
+/// i.e. each represents the function `x -> x + map.at(x)`.  The result maps
+/// `x` to `x + first.at(x) + second.at(x + first.at(x))`.  Offsets must not
+/// move any piece beyond the range of `T`.
+template <typename T>
+interval_map<T, T> compose_offsets(const interval_map<T, T>& first,
+                                   const interval_map<T, T>& second)
+{
+    interval_map<T, T> out;
+    first.for_each(out.domain, [&](interval<T> piece, T first_offset) {
+        const interval<T> image{static_cast<T>(piece.lo + first_offset),
+                                static_cast<T>(piece.hi + first_offset)};
+        second.for_each(image, [&](interval<T> sub_image, T second_offset) {
+            out.assign({static_cast<T>(sub_image.lo - first_offset),
+                        static_cast<T>(sub_image.hi - first_offset)},
+                       static_cast<T>(first_offset + second_offset));
+        });
+    });
+    return out;
+}
+
+}  // namespace aoc
+
+#endif  // AOC_INTERVAL_HPP
@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_JSON_HPP
+#define AOC_JSON_HPP
+
+#include "aoc.hpp"
+#include "aoc_simd.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+// A streaming JSON scanner for puzzle inputs which are JSON documents.  It
+// makes one pass over the text, checking the grammar and calling a handler
+// for each token as it goes, SAX style, and never allocates: nothing is
+// built from the document unless the handler builds it.
+//
+// The handler is any object with some of these members; a token whose member
+// is missing is checked and skipped:
+//
+//     void begin_object();
+//     void end_object();
+//     void begin_array();
+//     void end_array();
+//     void key(std::string_view raw);     // an object member's name
+//     void string(std::string_view raw);  // a string value
+//     void number(std::string_view text);
+//     void boolean(bool value);
+//     void null();
+//
+// Strings are passed as the raw text between the quotes, escapes and all, so
+// they can be views into the input.  Numbers are passed as their text, for
+// the handler to convert to whichever type it wants, for example with
+// `aoc::to_num`.
+
+namespace aoc::json {
+
+// Deepest nesting of arrays and objects accepted, which bounds the scanner's
+// stack.  Handlers which keep something per level can size their own stacks
+// with this.
+inline constexpr std::size_t max_depth{256};
+
+namespace detail {
+
+constexpr bool is_space(char c) noexcept
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+constexpr bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+[[noreturn]] inline void syntax_error(std::size_t pos, std::string_view what)
+{
+    throw input_error{fmt::format("JSON error at offset {}: {}", pos, what)};
+}
+
+// End of the string whose opening quote is at `pos`, one past its closing
+// quote.  A quote is escaped if an odd number of backslashes precede it.
+inline std::size_t scan_string(std::string_view text, std::size_t pos)
+{
+    std::size_t end{pos + 1};
+    for (;;) {
+        const auto rest{std::span{text}.subspan(end)};
+        const auto quote{end + find_equal(rest, '"')};
+        if (quote == text.size()) {
+            syntax_error(pos, "unterminated string");
+        }
+        std::size_t backslashes{0};
+        while (text[quote - backslashes - 1] == '\\') {
+            backslashes++;
+        }
+        if (backslashes % 2 == 0) {
+            return quote + 1;
+        }
+        end = quote + 1;
+    }
+}
+
+// End of the number starting at `pos`, which must be a `-` or a digit.
+inline std::size_t scan_number(std::string_view text, std::size_t pos)
+{
+    const auto digit_at{[&text](std::size_t i) {
+        return i < text.size() && is_digit(text[i]);
+    }};
+    const auto skip_digits{[&](std::size_t i) {
+        if (!digit_at(i)) {
+            syntax_error(i, "expected a digit");
+        }
+        while (digit_at(i)) {
+            i++;
+        }
+        return i;
+    }};
+
+    std::size_t i{pos};
+    if (text[i] == '-') {
+        i++;
+    }
+    // No leading zeroes.
+    i = (i < text.size() && text[i] == '0') ? i + 1 : skip_digits(i);
+    if (i < text.size() && text[i] == '.') {
+        i = skip_digits(i + 1);
+    }
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+        i++;
+        if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+            i++;
+        }
+        i = skip_digits(i);
+    }
+    return i;
+}
+
+}  // namespace detail
+
+// Scan the JSON document `text`, calling `handler` for each token in order.
+// Throws `aoc::input_error` if the text isn't exactly one JSON value (with
+// optional surrounding whitespace) or nests deeper than `max_depth`; the
+// handler will have seen the tokens before the error.
+template <typename Handler>
+void scan(std::string_view text, Handler& handler)
+{
+    // What may come next.
+    enum class expect {
+        value,
+        value_or_end,  // just after '['
+        key,
+        key_or_end,  // just after '{'
+        colon,
+        comma_or_end,
+        nothing,  // after the top level value
+    };
+
+    // Whether each open container is an object, since ',' and the closing
+    // bracket depend on it.
+    std::array<bool, max_depth> in_object;
+    std::size_t depth{0};
+    expect next{expect::value};
+    std::size_t pos{0};
+
+    const auto after_value{[&] {
+        next = depth == 0 ? expect::nothing : expect::comma_or_end;
+    }};
+    const auto open{[&](bool object) {
+        if (depth == max_depth) {
+            detail::syntax_error(pos, "nested too deeply");
+        }
+        in_object[depth++] = object;
+        if (object) {
+            if constexpr (requires { handler.begin_object(); }) {
+                handler.begin_object();
+            }
+            next = expect::key_or_end;
+        }
+        else {
+            if constexpr (requires { handler.begin_array(); }) {
+                handler.begin_array();
+            }
+            next = expect::value_or_end;
+        }
+    }};
+    const auto close{[&](bool object) {
+        depth--;
+        if (object) {
+            if constexpr (requires { handler.end_object(); }) {
+                handler.end_object();
+            }
+        }
+        else {
+            if constexpr (requires { handler.end_array(); }) {
+                handler.end_array();
+            }
+        }
+        after_value();
+    }};
+    const auto literal{[&](std::string_view word) {
+        if (text.substr(pos, word.size()) != word) {
+            detail::syntax_error(pos, "unexpected character");
+        }
+        pos += word.size();
+        after_value();
+    }};
+
+    while (pos < text.size()) {
+        const char c{text[pos]};
+        if (detail::is_space(c)) {
+            pos++;
+            continue;
+        }
+
+        switch (next) {
+            case expect::value_or_end:
+                if (c == ']') {
+                    pos++;
+                    close(false);
+                    continue;
+                }
+                [[fallthrough]];
+            case expect::value:
+                if (c == '{' || c == '[') {
+                    pos++;
+                    open(c == '{');
+                }
+                else if (c == '"') {
+                    const auto end{detail::scan_string(text, pos)};
+                    if constexpr (requires { handler.string(text); }) {
+                        handler.string(text.substr(pos + 1, end - pos - 2));
+                    }
+                    pos = end;
+                    after_value();
+                }
+                else if (c == '-' || detail::is_digit(c)) {
+                    const auto end{detail::scan_number(text, pos)};
+                    if constexpr (requires { handler.number(text); }) {
+                        handler.number(text.substr(pos, end - pos));
+                    }
+                    pos = end;
+                    after_value();
+                }
+                else if (c == 't' || c == 'f') {
+                    literal(c == 't' ? "true" : "false");
+                    if constexpr (requires { handler.boolean(true); }) {
+                        handler.boolean(c == 't');
+                    }
+                }
+                else if (c == 'n') {
+                    literal("null");
+                    if constexpr (requires { handler.null(); }) {
+                        handler.null();
+                    }
+                }
+                else {
+                    detail::syntax_error(pos, "expected a value");
+                }
+                break;
+
+            case expect::key_or_end:
+                if (c == '}') {
+                    pos++;
+                    close(true);
+                    continue;
+                }
+                [[fallthrough]];
+            case expect::key:
+                if (c != '"') {
+                    detail::syntax_error(pos, "expected a key");
+                }
+                else {
+                    const auto end{detail::scan_string(text, pos)};
+                    if constexpr (requires { handler.key(text); }) {
+                        handler.key(text.substr(pos + 1, end - pos - 2));
+                    }
+                    pos = end;
+                    next = expect::colon;
+                }
+                break;
+
+            case expect::colon:
+                if (c != ':') {
+                    detail::syntax_error(pos, "expected ':'");
+                }
+                pos++;
+                next = expect::value;
+                break;
+
+            case expect::comma_or_end:
+                if (c == ',') {
+                    pos++;
+                    next = in_object[depth - 1] ? expect::key : expect::value;
+                }
+                else if (c == (in_object[depth - 1] ? '}' : ']')) {
+                    pos++;
+                    close(in_object[depth - 1]);
+                }
+                else {
+                    detail::syntax_error(pos, "expected ',' or a close");
+                }
+                break;
+
+            case expect::nothing:
+                detail::syntax_error(pos, "text after the value");
+        }
+    }
+
+    if (next != expect::nothing) {
+        detail::syntax_error(pos, "unexpected end of input");
+    }
+}
+
+}  // namespace aoc::json
+
+#endif  // AOC_JSON_HPP
@@ -0,0 +1,459 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "aoc_md5.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define AOC_MD5_AVX512
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define AOC_MD5_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_MD5_SSE2
+#endif
+
+namespace aoc {
+
+namespace {
+
+// RFC 1321, with the steps numbered 0 to 63.
+constexpr std::array<std::uint32_t, 64> sines{
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+constexpr std::array<int, 16> shifts{7, 12, 17, 22, 5, 9,  14, 20,
+                                     4, 11, 16, 23, 6, 10, 15, 21};
+
+constexpr std::array<std::uint32_t, 4> initial_state{0x67452301, 0xefcdab89,
+                                                     0x98badcfe, 0x10325476};
+
+constexpr std::size_t word_index(std::size_t step)
+{
+    switch (step / 16) {
+        case 0:
+            return step;
+        case 1:
+            return (5 * step + 1) % 16;
+        case 2:
+            return (3 * step + 5) % 16;
+        default:
+            return (7 * step) % 16;
+    }
+}
+
+// Each set of lane operations holds one 32-bit word per message.  `choose`
+// is the bitwise `m ? a : b`, which is the round function of the first two
+// rounds; `h` and `i` are those of the last two.
+struct scalar_ops {
+    using vec = std::uint32_t;
+    static constexpr std::size_t width{1};
+
+    static vec set1(std::uint32_t x) noexcept { return x; }
+    static vec load(const std::uint32_t* p) noexcept { return *p; }
+    static void store(std::uint32_t* p, vec v) noexcept { *p = v; }
+    static vec add(vec a, vec b) noexcept { return a + b; }
+    static vec choose(vec m, vec a, vec b) noexcept
+    {
+        return b ^ (m & (a ^ b));
+    }
+    static vec h(vec b, vec c, vec d) noexcept { return b ^ c ^ d; }
+    static vec i(vec b, vec c, vec d) noexcept { return c ^ (b | ~d); }
+    template <int S>
+    static vec rotl(vec a) noexcept
+    {
+        return std::rotl(a, S);
+    }
+};
+
+#if defined(AOC_MD5_AVX512)
+struct simd_ops {
+    using vec = __m512i;
+    static constexpr std::size_t width{16};
+
+    static vec set1(std::uint32_t x) noexcept
+    {
+        return _mm512_set1_epi32(static_cast<int>(x));
+    }
+    static vec load(const std::uint32_t* p) noexcept
+    {
+        return _mm512_load_si512(p);
+    }
+    static void store(std::uint32_t* p, vec v) noexcept
+    {
+        _mm512_store_si512(p, v);
+    }
+    static vec add(vec a, vec b) noexcept { return _mm512_add_epi32(a, b); }
+    static vec choose(vec m, vec a, vec b) noexcept
+    {
+        return _mm512_ternarylogic_epi32(m, a, b, 0xca);
+    }
+    static vec h(vec b, vec c, vec d) noexcept
+    {
+        return _mm512_ternarylogic_epi32(b, c, d, 0x96);
+    }
+    static vec i(vec b, vec c, vec d) noexcept
+    {
+        return _mm512_ternarylogic_epi32(b, c, d, 0x39);
+    }
+    template <int S>
+    static vec rotl(vec a) noexcept
+    {
+        // The unmasked form trips -Wuninitialized inside some GCC headers.
+        return _mm512_maskz_rol_epi32(0xffff, a, S);
+    }
+};
+#elif defined(AOC_MD5_AVX2)
+struct simd_ops {
+    using vec = __m256i;
+    static constexpr std::size_t width{8};
+
+    static vec set1(std::uint32_t x) noexcept
+    {
+        return _mm256_set1_epi32(static_cast<int>(x));
+    }
+    static vec load(const std::uint32_t* p) noexcept
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void store(std::uint32_t* p, vec v) noexcept
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static vec add(vec a, vec b) noexcept { return _mm256_add_epi32(a, b); }
+    static vec choose(vec m, vec a, vec b) noexcept
+    {
+        const vec diff{_mm256_xor_si256(a, b)};
+        return _mm256_xor_si256(b, _mm256_and_si256(m, diff));
+    }
+    static vec h(vec b, vec c, vec d) noexcept
+    {
+        return _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+    }
+    static vec i(vec b, vec c, vec d) noexcept
+    {
+        const vec not_d{_mm256_xor_si256(d, _mm256_set1_epi32(-1))};
+        return _mm256_xor_si256(c, _mm256_or_si256(b, not_d));
+    }
+    template <int S>
+    static vec rotl(vec a) noexcept
+    {
+        return _mm256_or_si256(_mm256_slli_epi32(a, S),
+                               _mm256_srli_epi32(a, 32 - S));
+    }
+};
+#elif defined(AOC_MD5_SSE2)
+struct simd_ops {
+    using vec = __m128i;
+    static constexpr std::size_t width{4};
+
+    static vec set1(std::uint32_t x) noexcept
+    {
+        return _mm_set1_epi32(static_cast<int>(x));
+    }
+    static vec load(const std::uint32_t* p) noexcept
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static void store(std::uint32_t* p, vec v) noexcept
+    {
+        _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+    static vec add(vec a, vec b) noexcept { return _mm_add_epi32(a, b); }
+    static vec choose(vec m, vec a, vec b) noexcept
+    {
+        return _mm_xor_si128(b, _mm_and_si128(m, _mm_xor_si128(a, b)));
+    }
+    static vec h(vec b, vec c, vec d) noexcept
+    {
+        return _mm_xor_si128(_mm_xor_si128(b, c), d);
+    }
+    static vec i(vec b, vec c, vec d) noexcept
+    {
+        const vec not_d{_mm_xor_si128(d, _mm_set1_epi32(-1))};
+        return _mm_xor_si128(c, _mm_or_si128(b, not_d));
+    }
+    template <int S>
+    static vec rotl(vec a) noexcept
+    {
+        return _mm_or_si128(_mm_slli_epi32(a, S), _mm_srli_epi32(a, 32 - S));
+    }
+};
+#else
+using simd_ops = scalar_ops;
+#endif
+
+// One step of the compression.  The four state words rotate roles each
+// step, so rather than moving them, step `I` picks which of them plays `a`.
+template <typename Ops, std::size_t I>
+inline void step(typename Ops::vec (&v)[4], const typename Ops::vec (&m)[16])
+{
+    auto& a{v[(4 - I % 4) % 4]};
+    const auto b{v[(5 - I % 4) % 4]};
+    const auto c{v[(6 - I % 4) % 4]};
+    const auto d{v[(7 - I % 4) % 4]};
+    typename Ops::vec f;
+    if constexpr (I < 16) {
+        f = Ops::choose(b, c, d);
+    }
+    else if constexpr (I < 32) {
+        f = Ops::choose(d, b, c);
+    }
+    else if constexpr (I < 48) {
+        f = Ops::h(b, c, d);
+    }
+    else {
+        f = Ops::i(b, c, d);
+    }
+    const auto sum{Ops::add(Ops::add(a, f),
+                            Ops::add(m[word_index(I)], Ops::set1(sines[I])))};
+    a = Ops::add(b, Ops::template rotl<shifts[(I / 16) * 4 + I % 4]>(sum));
+}
+
+template <typename Ops, std::size_t... Is>
+inline void compress_lanes(typename Ops::vec (&v)[4],
+                           const typename Ops::vec (&m)[16],
+                           std::index_sequence<Is...>)
+{
+    const typename Ops::vec saved[4]{v[0], v[1], v[2], v[3]};
+    (step<Ops, Is>(v, m), ...);
+    for (std::size_t k{0}; k < 4; k++) {
+        v[k] = Ops::add(v[k], saved[k]);
+    }
+}
+
+// Compress one block for each lane.  `words[j]` holds word `j` of every
+// lane's block, and `state[k]` word `k` of every lane's state.
+template <typename Ops>
+struct lanes {
+    alignas(64) std::uint32_t words[16][Ops::width];
+    alignas(64) std::uint32_t state[4][Ops::width];
+
+    void compress() noexcept
+    {
+        typename Ops::vec v[4];
+        typename Ops::vec m[16];
+        for (std::size_t k{0}; k < 4; k++) {
+            v[k] = Ops::load(state[k]);
+        }
+        for (std::size_t j{0}; j < 16; j++) {
+            m[j] = Ops::load(words[j]);
+        }
+        compress_lanes<Ops>(v, m, std::make_index_sequence<64>{});
+        for (std::size_t k{0}; k < 4; k++) {
+            Ops::store(state[k], v[k]);
+        }
+    }
+};
+
+std::uint32_t load_le(const unsigned char* p) noexcept
+{
+    return std::uint32_t{p[0]} | (std::uint32_t{p[1]} << 8) |
+           (std::uint32_t{p[2]} << 16) | (std::uint32_t{p[3]} << 24);
+}
+
+void compress_one(std::array<std::uint32_t, 4>& state,
+                  const std::array<std::uint32_t, 16>& block) noexcept
+{
+    lanes<scalar_ops> l;
+    for (std::size_t j{0}; j < 16; j++) {
+        l.words[j][0] = block[j];
+    }
+    for (std::size_t k{0}; k < 4; k++) {
+        l.state[k][0] = state[k];
+    }
+    l.compress();
+    for (std::size_t k{0}; k < 4; k++) {
+        state[k] = l.state[k][0];
+    }
+}
+
+void compress_one(std::array<std::uint32_t, 4>& state,
+                  const unsigned char* bytes) noexcept
+{
+    std::array<std::uint32_t, 16> block;
+    for (std::size_t j{0}; j < 16; j++) {
+        block[j] = load_le(bytes + 4 * j);
+    }
+    compress_one(state, block);
+}
+
+md5_digest to_digest(const std::array<std::uint32_t, 4>& state) noexcept
+{
+    md5_digest digest;
+    for (std::size_t k{0}; k < 4; k++) {
+        for (std::size_t b{0}; b < 4; b++) {
+            digest[4 * k + b] = static_cast<std::uint8_t>(state[k] >> (8 * b));
+        }
+    }
+    return digest;
+}
+
+}  // namespace
+
+std::size_t md5_lanes() noexcept
+{
+    return simd_ops::width;
+}
+
+md5_digest md5(std::string_view message) noexcept
+{
+    return md5_prefix{message}({});
+}
+
+std::string md5_hex(const md5_digest& digest)
+{
+    constexpr std::string_view hex{"0123456789abcdef"};
+    std::string s;
+    s.reserve(2 * digest.size());
+    for (const std::uint8_t byte : digest) {
+        s += hex[byte >> 4];
+        s += hex[byte & 0xf];
+    }
+    return s;
+}
+
+md5_prefix::md5_prefix(std::string_view prefix) noexcept
+    : state_{initial_state}
+{
+    const auto* bytes{reinterpret_cast<const unsigned char*>(prefix.data())};
+    while (prefix.size() - hashed_size_ >= 64) {
+        compress_one(state_, bytes + hashed_size_);
+        hashed_size_ += 64;
+    }
+    tail_size_ = prefix.size() - hashed_size_;
+    std::copy_n(prefix.data() + hashed_size_, tail_size_, tail_.data());
+}
+
+void md5_prefix::final_block(
+    std::string_view suffix,
+    std::array<std::uint32_t, 16>& block) const noexcept
+{
+    std::array<unsigned char, 64> bytes{};
+    std::copy_n(tail_.data(), tail_size_, bytes.data());
+    std::copy_n(suffix.data(), suffix.size(), bytes.data() + tail_size_);
+    const std::size_t size{tail_size_ + suffix.size()};
+    bytes[size] = 0x80;
+    for (std::size_t j{0}; j < 14; j++) {
+        block[j] = load_le(bytes.data() + 4 * j);
+    }
+    const std::uint64_t bits{(hashed_size_ + size) * 8};
+    block[14] = static_cast<std::uint32_t>(bits);
+    block[15] = static_cast<std::uint32_t>(bits >> 32);
+}
+
+md5_digest md5_prefix::operator()(std::string_view suffix) const noexcept
+{
+    auto state{state_};
+    if (fits_one_block(suffix)) {
+        std::array<std::uint32_t, 16> block;
+        final_block(suffix, block);
+        compress_one(state, block);
+        return to_digest(state);
+    }
+
+    // Whole blocks straight from the suffix once the tail is topped up, then
+    // one or two blocks of whatever is left plus the padding.
+    std::array<unsigned char, 128> buffer{};
+    std::copy_n(tail_.data(), tail_size_, buffer.data());
+    std::size_t buffered{tail_size_};
+    std::uint64_t size{hashed_size_ + tail_size_ + suffix.size()};
+    const auto* bytes{reinterpret_cast<const unsigned char*>(suffix.data())};
+    const std::size_t top_up{std::min(64 - buffered, suffix.size())};
+    std::copy_n(bytes, top_up, buffer.data() + buffered);
+    buffered += top_up;
+    std::size_t pos{top_up};
+    if (buffered == 64) {
+        compress_one(state, buffer.data());
+        buffered = 0;
+        for (; suffix.size() - pos >= 64; pos += 64) {
+            compress_one(state, bytes + pos);
+        }
+        std::copy_n(bytes + pos, suffix.size() - pos, buffer.data());
+        buffered = suffix.size() - pos;
+    }
+    std::fill(buffer.begin() + static_cast<std::ptrdiff_t>(buffered),
+              buffer.end(), 0);
+    buffer[buffered] = 0x80;
+    const std::size_t blocks{buffered < 56 ? 1U : 2U};
+    const std::uint64_t bits{size * 8};
+    for (std::size_t b{0}; b < 8; b++) {
+        buffer[64 * blocks - 8 + b] =
+            static_cast<unsigned char>(bits >> (8 * b));
+    }
+    for (std::size_t b{0}; b < blocks; b++) {
+        compress_one(state, buffer.data() + 64 * b);
+    }
+    return to_digest(state);
+}
+
+void md5_prefix::hash_many(std::span<const std::string_view> suffixes,
+                           std::span<md5_digest> digests) const
+{
+    constexpr std::size_t width{simd_ops::width};
+    lanes<simd_ops> l{};
+    std::array<std::size_t, width> lane_message{};
+    std::size_t used{0};
+
+    const auto flush{[&] {
+        for (std::size_t k{0}; k < 4; k++) {
+            std::fill_n(l.state[k], width, state_[k]);
+        }
+        l.compress();
+        for (std::size_t lane{0}; lane < used; lane++) {
+            std::array<std::uint32_t, 4> state;
+            for (std::size_t k{0}; k < 4; k++) {
+                state[k] = l.state[k][lane];
+            }
+            digests[lane_message[lane]] = to_digest(state);
+        }
+        used = 0;
+    }};
+
+    std::array<std::uint32_t, 16> block;
+    for (std::size_t n{0}; n < suffixes.size(); n++) {
+        if (!fits_one_block(suffixes[n])) {
+            digests[n] = (*this)(suffixes[n]);
+            continue;
+        }
+        final_block(suffixes[n], block);
+        for (std::size_t j{0}; j < 16; j++) {
+            l.words[j][used] = block[j];
+        }
+        lane_message[used++] = n;
+        if (used == width) {
+            flush();
+        }
+    }
+    if (used > 0) {
+        // The idle lanes hash whatever they held before; it is discarded.
+        flush();
+    }
+}
+
+}  // namespace aoc
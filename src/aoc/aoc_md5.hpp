@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_MD5_HPP
+#define AOC_MD5_HPP
+
+#include "aoc_parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace aoc {
+
+// MD5 for the puzzles which search for a hash with some property among many
+// short messages which share a prefix, such as "abcdef" followed by a number.
+//
+// - `md5_prefix` hashes the whole 64-byte blocks of the prefix once, and
+//   starts each message from the saved state.
+// - A message whose remaining bytes fit in one block (under 56 bytes, leaving
+//   room for the padding and length) takes one compression and no buffering.
+// - `md5_prefix::hash_many` runs the compression for several messages at once,
+//   one per 32-bit lane of an AVX-512, AVX2 or SSE2 register, whichever the
+//   compiler is targeting.
+
+using md5_digest = std::array<std::uint8_t, 16>;
+
+// Number of messages hashed side by side by `md5_prefix::hash_many`: 16, 8, 4
+// or 1.  Batches of a multiple of this keep every lane busy.
+std::size_t md5_lanes() noexcept;
+
+md5_digest md5(std::string_view message) noexcept;
+
+// Lowercase hex of a digest, which is what most puzzles hash again or inspect.
+std::string md5_hex(const md5_digest& digest);
+
+class md5_prefix {
+   public:
+    explicit md5_prefix(std::string_view prefix) noexcept;
+
+    // Digest of the prefix followed by `suffix`.
+    md5_digest operator()(std::string_view suffix) const noexcept;
+
+    // Digest of the prefix followed by each of `suffixes`, into the same
+    // position of `digests`, which must be at least as long.
+    void hash_many(std::span<const std::string_view> suffixes,
+                   std::span<md5_digest> digests) const;
+
+   private:
+    std::array<std::uint32_t, 4> state_;
+    // Bytes of the prefix already hashed into `state_`, a multiple of 64.
+    std::uint64_t hashed_size_{0};
+    // The rest of the prefix.
+    std::array<char, 64> tail_{};
+    std::size_t tail_size_{0};
+
+    bool fits_one_block(std::string_view suffix) const noexcept
+    {
+        return tail_size_ + suffix.size() < 56;
+    }
+
+    // Build the final block for `suffix`, which must fit in one block.
+    void final_block(std::string_view suffix,
+                     std::array<std::uint32_t, 16>& block) const noexcept;
+};
+
+// The decimal digits of a non-negative number, kept as text and incremented
+// in place, which is cheaper than formatting each number from scratch.
+class decimal_counter {
+   public:
+    explicit decimal_counter(std::int64_t value) noexcept
+    {
+        do {
+            digits_[--first_] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+    }
+
+    decimal_counter& operator++() noexcept
+    {
+        for (std::size_t i{digits_.size()}; i-- > first_;) {
+            if (digits_[i] != '9') {
+                ++digits_[i];
+                return *this;
+            }
+            digits_[i] = '0';
+        }
+        digits_[--first_] = '1';
+        return *this;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return {digits_.data() + first_, digits_.size() - first_};
+    }
+
+    // Copy the digits to `buffer`, returning a view of them there.  The whole
+    // buffer is copied, since a fixed-size copy is cheaper than a variable one.
+    std::string_view copy_to(std::array<char, 20>& buffer) const noexcept
+    {
+        buffer = digits_;
+        return {buffer.data() + first_, digits_.size() - first_};
+    }
+
+   private:
+    // Right aligned, with room for one more digit than any int64_t has.
+    std::array<char, 20> digits_{};
+    std::size_t first_{digits_.size()};
+};
+
+// For each predicate, the first number from `start` upward for which the
+// digest of `key` followed by the number in decimal satisfies it.  All of
+// the predicates are tested in one pass, which is split into chunks across
+// threads; each is called with a `const md5_digest&`, concurrently.
+template <typename... Preds>
+std::array<std::int64_t, sizeof...(Preds)> md5_find_first(
+    const md5_prefix& key, std::int64_t start, Preds... preds)
+{
+    constexpr std::size_t pred_count{sizeof...(Preds)};
+    constexpr std::int64_t chunk_size{1 << 14};
+    constexpr std::size_t batch{256};
+
+    const auto search_chunk{[&](std::int64_t first, std::int64_t last) {
+        std::array<std::int64_t, pred_count> found;
+        found.fill(no_match);
+        std::array<std::array<char, 20>, batch> numbers;
+        std::array<std::string_view, batch> suffixes;
+        std::array<md5_digest, batch> digests;
+        decimal_counter number{first};
+        for (std::int64_t base{first}; base < last;
+             base += static_cast<std::int64_t>(batch)) {
+            const auto count{static_cast<std::size_t>(
+                std::min(last - base, static_cast<std::int64_t>(batch)))};
+            for (std::size_t n{0}; n < count; n++, ++number) {
+                suffixes[n] = number.copy_to(numbers[n]);
+            }
+            key.hash_many(std::span{suffixes}.first(count), digests);
+            for (std::size_t n{0}; n < count; n++) {
+                const auto index{base + static_cast<std::int64_t>(n)};
+                [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+                    ((found[Ks] == no_match && preds(digests[n])
+                          ? void(found[Ks] = index)
+                          : void()),
+                     ...);
+                }(std::index_sequence_for<Preds...>{});
+            }
+            if (std::ranges::none_of(
+                    found, [](auto f) { return f == no_match; })) {
+                break;
+            }
+        }
+        return found;
+    }};
+
+    return parallel_find_first<pred_count>(start, chunk_size, search_chunk);
+}
+
+}  // namespace aoc
+
+#endif  // AOC_MD5_HPP
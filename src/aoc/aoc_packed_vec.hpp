@@ -0,0 +1,489 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_PACKED_VEC_HPP
+#define AOC_PACKED_VEC_HPP
+
+#include "aoc_hash.hpp"
+#include "aoc_vec.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Integer coordinates packed into one 64-bit word, for use as set and map keys
+// and in hot neighbour loops.  Comparing, hashing or stepping to a neighbour is
+// one word operation instead of one per coordinate.
+//
+// Each coordinate is biased to an unsigned field, and the fields are either
+// concatenated (`packing::lexicographic`, which orders points exactly like
+// vec2/vec3) or bit-interleaved (`packing::morton`, Z-order, which keeps
+// points that are near in space near in a sorted container).  A step is
+// stored as an `offset` in the same layout, and adding it needs no branches:
+// a plain add for lexicographic, or a masked add per coordinate for Morton.
+//
+// packed_vec2 holds coordinates in [-2^31, 2^31) and packed_vec3 holds them in
+// [-2^20, 2^20).  Moving a point out of range gives a meaningless result.
+
+namespace aoc {
+
+enum class packing { lexicographic, morton };
+
+namespace detail {
+
+// Spread the low 32 bits of `v` to the even bits of the result.
+constexpr std::uint64_t spread_bits2(std::uint64_t v) noexcept
+{
+    v &= 0xffffffffULL;
+    v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+    v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+    v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | (v << 2)) & 0x3333333333333333ULL;
+    v = (v | (v << 1)) & 0x5555555555555555ULL;
+    return v;
+}
+
+constexpr std::uint64_t compact_bits2(std::uint64_t v) noexcept
+{
+    v &= 0x5555555555555555ULL;
+    v = (v | (v >> 1)) & 0x3333333333333333ULL;
+    v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | (v >> 4)) & 0x00ff00ff00ff00ffULL;
+    v = (v | (v >> 8)) & 0x0000ffff0000ffffULL;
+    v = (v | (v >> 16)) & 0x00000000ffffffffULL;
+    return v;
+}
+
+// Spread the low 21 bits of `v` to every third bit of the result.
+constexpr std::uint64_t spread_bits3(std::uint64_t v) noexcept
+{
+    v &= 0x1fffffULL;
+    v = (v | (v << 32)) & 0x001f00000000ffffULL;
+    v = (v | (v << 16)) & 0x001f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+constexpr std::uint64_t compact_bits3(std::uint64_t v) noexcept
+{
+    v &= 0x1249249249249249ULL;
+    v = (v | (v >> 2)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v >> 4)) & 0x100f00f00f00f00fULL;
+    v = (v | (v >> 8)) & 0x001f0000ff0000ffULL;
+    v = (v | (v >> 16)) & 0x001f00000000ffffULL;
+    v = (v | (v >> 32)) & 0x1fffffULL;
+    return v;
+}
+
+// The 64-bit two's complement of `v`.
+constexpr std::uint64_t sign_extend(std::int32_t v) noexcept
+{
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+}
+
+// Add or subtract the fields selected by `mask` (of any layout) of two
+// words, with carries and borrows crossing the gaps between field bits.
+// Lanes wrap around independently.
+constexpr std::uint64_t masked_add(std::uint64_t a,
+                                   std::uint64_t b,
+                                   std::uint64_t mask) noexcept
+{
+    return ((a | ~mask) + (b & mask)) & mask;
+}
+
+constexpr std::uint64_t masked_sub(std::uint64_t a,
+                                   std::uint64_t b,
+                                   std::uint64_t mask) noexcept
+{
+    return ((a & mask) - (b & mask)) & mask;
+}
+
+}  // namespace detail
+
+/// @brief A 2D point with 32-bit coordinates packed into one word.  It
+/// converts implicitly to `vec2<int>`, so it can index grids and rects.
+template <packing Packing = packing::lexicographic>
+class packed_vec2 {
+   public:
+    using scalar_type = std::int32_t;
+
+    /// @brief A step between points, in the same layout.
+    class offset {
+       public:
+        constexpr offset() noexcept = default;
+        constexpr offset(scalar_type dx, scalar_type dy) noexcept
+            : bits_{packed_vec2::encode_delta(dx, dy)}
+        {
+        }
+
+        static constexpr offset from_bits(std::uint64_t bits) noexcept
+        {
+            offset out;
+            out.bits_ = bits;
+            return out;
+        }
+
+        constexpr std::uint64_t bits() const noexcept { return bits_; }
+
+        friend constexpr bool operator==(offset, offset) noexcept = default;
+
+       private:
+        std::uint64_t bits_{0};
+    };
+
+    constexpr packed_vec2() noexcept : packed_vec2{0, 0} {}
+    constexpr packed_vec2(scalar_type x, scalar_type y) noexcept
+        : bits_{encode(x, y)}
+    {
+    }
+    constexpr explicit packed_vec2(vec2<int> v) noexcept : packed_vec2{v.x, v.y}
+    {
+    }
+
+    static constexpr packed_vec2 from_bits(std::uint64_t bits) noexcept
+    {
+        packed_vec2 out;
+        out.bits_ = bits;
+        return out;
+    }
+
+    constexpr std::uint64_t bits() const noexcept { return bits_; }
+
+    constexpr scalar_type x() const noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return unbias(detail::compact_bits2(bits_ >> 1));
+        }
+        else {
+            return unbias(bits_ >> 32);
+        }
+    }
+
+    constexpr scalar_type y() const noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return unbias(detail::compact_bits2(bits_));
+        }
+        else {
+            return unbias(bits_);
+        }
+    }
+
+    constexpr operator vec2<int>() const noexcept { return {x(), y()}; }
+
+    friend constexpr packed_vec2 operator+(packed_vec2 p, offset d) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return from_bits(detail::masked_add(p.bits_, d.bits(), x_mask) |
+                             detail::masked_add(p.bits_, d.bits(), y_mask));
+        }
+        else {
+            return from_bits(p.bits_ + d.bits());
+        }
+    }
+
+    constexpr packed_vec2& operator+=(offset d) noexcept
+    {
+        return *this = *this + d;
+    }
+
+    /// @brief The step from `q` to `p`.
+    friend constexpr offset operator-(packed_vec2 p, packed_vec2 q) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return offset::from_bits(
+                detail::masked_sub(p.bits_, q.bits_, x_mask) |
+                detail::masked_sub(p.bits_, q.bits_, y_mask));
+        }
+        else {
+            return offset::from_bits(p.bits_ - q.bits_);
+        }
+    }
+
+    /// @brief Steps to the four orthogonal neighbours.
+    static constexpr std::array<offset, 4> orthogonal_offsets() noexcept
+    {
+        return {offset{-1, 0}, offset{1, 0}, offset{0, -1}, offset{0, 1}};
+    }
+
+    /// @brief Steps to the eight neighbours, including diagonals.
+    static constexpr std::array<offset, 8> all_offsets() noexcept
+    {
+        return {offset{-1, -1}, offset{-1, 0}, offset{-1, 1}, offset{0, -1},
+                offset{0, 1},   offset{1, -1}, offset{1, 0},  offset{1, 1}};
+    }
+
+    constexpr std::array<packed_vec2, 4> orthogonal_neighbors() const noexcept
+    {
+        std::array<packed_vec2, 4> out;
+        const auto offsets{orthogonal_offsets()};
+        for (std::size_t i{0}; i < offsets.size(); i++) {
+            out[i] = *this + offsets[i];
+        }
+        return out;
+    }
+
+    friend constexpr auto operator<=>(packed_vec2, packed_vec2) noexcept =
+        default;
+
+   private:
+    static constexpr std::uint64_t x_mask{0xaaaaaaaaaaaaaaaaULL};
+    static constexpr std::uint64_t y_mask{0x5555555555555555ULL};
+
+    std::uint64_t bits_;
+
+    // Flipping the sign bit maps [-2^31, 2^31) onto [0, 2^32) in order.
+    static constexpr std::uint64_t bias(scalar_type v) noexcept
+    {
+        return static_cast<std::uint32_t>(v) ^ 0x80000000U;
+    }
+
+    static constexpr scalar_type unbias(std::uint64_t field) noexcept
+    {
+        return static_cast<scalar_type>(static_cast<std::uint32_t>(field) ^
+                                        0x80000000U);
+    }
+
+    static constexpr std::uint64_t encode(scalar_type x, scalar_type y) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return (detail::spread_bits2(bias(x)) << 1) |
+                   detail::spread_bits2(bias(y));
+        }
+        else {
+            return (bias(x) << 32) | bias(y);
+        }
+    }
+
+    // Steps are unbiased two's complement in each field; for lexicographic
+    // packing the borrow from a negative dy into the x field is exactly what
+    // makes a plain add work.
+    static constexpr std::uint64_t encode_delta(scalar_type dx,
+                                                scalar_type dy) noexcept
+    {
+        const std::uint64_t udx{detail::sign_extend(dx)};
+        const std::uint64_t udy{detail::sign_extend(dy)};
+        if constexpr (Packing == packing::morton) {
+            return (detail::spread_bits2(udx) << 1) | detail::spread_bits2(udy);
+        }
+        else {
+            return (udx << 32) + udy;
+        }
+    }
+};
+
+/// @brief A 3D point with 21-bit coordinates packed into one word.  It
+/// converts implicitly to `vec3<int>`.
+template <packing Packing = packing::lexicographic>
+class packed_vec3 {
+   public:
+    using scalar_type = std::int32_t;
+
+    /// @brief A step between points, in the same layout.
+    class offset {
+       public:
+        constexpr offset() noexcept = default;
+        constexpr offset(scalar_type dx,
+                         scalar_type dy,
+                         scalar_type dz) noexcept
+            : bits_{packed_vec3::encode_delta(dx, dy, dz)}
+        {
+        }
+
+        static constexpr offset from_bits(std::uint64_t bits) noexcept
+        {
+            offset out;
+            out.bits_ = bits;
+            return out;
+        }
+
+        constexpr std::uint64_t bits() const noexcept { return bits_; }
+
+        friend constexpr bool operator==(offset, offset) noexcept = default;
+
+       private:
+        std::uint64_t bits_{0};
+    };
+
+    constexpr packed_vec3() noexcept : packed_vec3{0, 0, 0} {}
+    constexpr packed_vec3(scalar_type x, scalar_type y, scalar_type z) noexcept
+        : bits_{encode(x, y, z)}
+    {
+    }
+    constexpr explicit packed_vec3(vec3<int> v) noexcept
+        : packed_vec3{v.x, v.y, v.z}
+    {
+    }
+
+    static constexpr packed_vec3 from_bits(std::uint64_t bits) noexcept
+    {
+        packed_vec3 out;
+        out.bits_ = bits;
+        return out;
+    }
+
+    constexpr std::uint64_t bits() const noexcept { return bits_; }
+
+    constexpr scalar_type x() const noexcept { return field(2); }
+    constexpr scalar_type y() const noexcept { return field(1); }
+    constexpr scalar_type z() const noexcept { return field(0); }
+
+    constexpr operator vec3<int>() const noexcept { return {x(), y(), z()}; }
+
+    friend constexpr packed_vec3 operator+(packed_vec3 p, offset d) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return from_bits(detail::masked_add(p.bits_, d.bits(), masks[0]) |
+                             detail::masked_add(p.bits_, d.bits(), masks[1]) |
+                             detail::masked_add(p.bits_, d.bits(), masks[2]));
+        }
+        else {
+            // Wrap within the 63 bits of the fields.
+            return from_bits((p.bits_ + d.bits()) & all_mask);
+        }
+    }
+
+    constexpr packed_vec3& operator+=(offset d) noexcept
+    {
+        return *this = *this + d;
+    }
+
+    /// @brief The step from `q` to `p`.
+    friend constexpr offset operator-(packed_vec3 p, packed_vec3 q) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return offset::from_bits(
+                detail::masked_sub(p.bits_, q.bits_, masks[0]) |
+                detail::masked_sub(p.bits_, q.bits_, masks[1]) |
+                detail::masked_sub(p.bits_, q.bits_, masks[2]));
+        }
+        else {
+            return offset::from_bits(p.bits_ - q.bits_);
+        }
+    }
+
+    /// @brief Steps to the six neighbours which share a face.
+    static constexpr std::array<offset, 6> face_offsets() noexcept
+    {
+        return {offset{-1, 0, 0}, offset{1, 0, 0},  offset{0, -1, 0},
+                offset{0, 1, 0},  offset{0, 0, -1}, offset{0, 0, 1}};
+    }
+
+    constexpr std::array<packed_vec3, 6> face_neighbors() const noexcept
+    {
+        std::array<packed_vec3, 6> out;
+        const auto offsets{face_offsets()};
+        for (std::size_t i{0}; i < offsets.size(); i++) {
+            out[i] = *this + offsets[i];
+        }
+        return out;
+    }
+
+    friend constexpr auto operator<=>(packed_vec3, packed_vec3) noexcept =
+        default;
+
+   private:
+    static constexpr int field_bits{21};
+    static constexpr std::uint64_t field_mask{
+        (std::uint64_t{1} << field_bits) - 1};
+    static constexpr std::uint64_t all_mask{
+        (std::uint64_t{1} << (3 * field_bits)) - 1};
+    // Masks of the z, y and x fields of a Morton code.
+    static constexpr std::array<std::uint64_t, 3> masks{
+        0x1249249249249249ULL, 0x1249249249249249ULL << 1,
+        0x1249249249249249ULL << 2};
+
+    std::uint64_t bits_;
+
+    // Field 0 is z, 1 is y and 2 is x.
+    constexpr scalar_type field(int i) const noexcept
+    {
+        std::uint64_t biased{};
+        if constexpr (Packing == packing::morton) {
+            biased = detail::compact_bits3(bits_ >> i);
+        }
+        else {
+            biased = (bits_ >> (i * field_bits)) & field_mask;
+        }
+        return static_cast<scalar_type>(biased) - (1 << (field_bits - 1));
+    }
+
+    static constexpr std::uint64_t bias(scalar_type v) noexcept
+    {
+        constexpr std::uint64_t half{std::uint64_t{1} << (field_bits - 1)};
+        return (detail::sign_extend(v) + half) & field_mask;
+    }
+
+    static constexpr std::uint64_t encode(scalar_type x,
+                                          scalar_type y,
+                                          scalar_type z) noexcept
+    {
+        if constexpr (Packing == packing::morton) {
+            return (detail::spread_bits3(bias(x)) << 2) |
+                   (detail::spread_bits3(bias(y)) << 1) |
+                   detail::spread_bits3(bias(z));
+        }
+        else {
+            return (bias(x) << (2 * field_bits)) | (bias(y) << field_bits) |
+                   bias(z);
+        }
+    }
+
+    static constexpr std::uint64_t encode_delta(scalar_type dx,
+                                                scalar_type dy,
+                                                scalar_type dz) noexcept
+    {
+        const std::uint64_t udx{detail::sign_extend(dx)};
+        const std::uint64_t udy{detail::sign_extend(dy)};
+        const std::uint64_t udz{detail::sign_extend(dz)};
+        if constexpr (Packing == packing::morton) {
+            return (detail::spread_bits3(udx) << 2) |
+                   (detail::spread_bits3(udy) << 1) | detail::spread_bits3(udz);
+        }
+        else {
+            return (udx << (2 * field_bits)) + (udy << field_bits) + udz;
+        }
+    }
+};
+
+}  // namespace aoc
+
+template <aoc::packing Packing>
+struct std::hash<aoc::packed_vec2<Packing>> {
+    std::size_t operator()(aoc::packed_vec2<Packing> p) const noexcept
+    {
+        return static_cast<std::size_t>(aoc::detail::fmix64(p.bits()));
+    }
+};
+
+template <aoc::packing Packing>
+struct std::hash<aoc::packed_vec3<Packing>> {
+    std::size_t operator()(aoc::packed_vec3<Packing> p) const noexcept
+    {
+        return static_cast<std::size_t>(aoc::detail::fmix64(p.bits()));
+    }
+};
+
+template <aoc::packing Packing>
+struct fmt::formatter<aoc::packed_vec2<Packing>>
+    : fmt::formatter<aoc::vec2<int>> {
+    template <typename FormatContext>
+    auto format(aoc::packed_vec2<Packing> p, FormatContext& ctx)
+        -> decltype(ctx.out())
+    {
+        return fmt::formatter<aoc::vec2<int>>::format(
+            static_cast<aoc::vec2<int>>(p), ctx);
+    }
+};
+
+#endif  // AOC_PACKED_VEC_HPP
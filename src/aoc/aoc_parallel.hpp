@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_PARALLEL_HPP
+#define AOC_PARALLEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+/// @brief Value reported by a chunk search for a condition it did not meet.
+inline constexpr std::int64_t no_match{
+    std::numeric_limits<std::int64_t>::max()};
+
+/// @brief Number of threads to use for CPU-bound work.
+inline std::size_t worker_count() noexcept
+{
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// @brief Find, for each of `N` conditions, the first index from `start`
+/// upward which meets it, searching chunks of indexes on several threads.
+///
+/// Threads claim chunks in increasing order from a shared counter, so once a
+/// claimed chunk starts past every condition's best index so far, no later
+/// chunk can improve on them and the threads stop.  Chunks already claimed
+/// below that point are finished first, so the results are the true minimums,
+/// the same as a sequential search.
+/// @tparam N Number of conditions searched for in the same pass.
+/// @tparam Search Callable taking the bounds `[first, last)` of a chunk and
+/// returning a `std::array<std::int64_t, N>` holding, for each condition, the
+/// first index in the chunk which meets it, or `no_match`.  It is called
+/// concurrently, so any state it keeps must be per call.
+/// @param start First index to search.
+/// @param chunk_size Indexes per chunk; large enough to make claiming a chunk
+/// cheap, small enough not to do much work past the answer.
+/// @param search The chunk search.
+/// @param threads Number of threads to search on, including the caller's.
+template <std::size_t N, typename Search>
+std::array<std::int64_t, N> parallel_find_first(
+    std::int64_t start, std::int64_t chunk_size, Search search,
+    std::size_t threads = worker_count())
+{
+    std::atomic<std::int64_t> next_chunk{start};
+    std::array<std::atomic<std::int64_t>, N> best;
+    for (auto& b : best) {
+        b.store(no_match, std::memory_order_relaxed);
+    }
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto all_found_before{[&best](std::int64_t index) {
+        return std::ranges::all_of(best, [index](const auto& b) {
+            return b.load(std::memory_order_relaxed) <= index;
+        });
+    }};
+
+    const auto worker{[&] {
+        try {
+            for (;;) {
+                const std::int64_t first{next_chunk.fetch_add(chunk_size)};
+                if (all_found_before(first)) {
+                    return;
+                }
+                const auto found{search(first, first + chunk_size)};
+                for (std::size_t k{0}; k < N; k++) {
+                    auto current{best[k].load(std::memory_order_relaxed)};
+                    while (found[k] < current &&
+                           !best[k].compare_exchange_weak(current, found[k])) {
+                    }
+                }
+            }
+        }
+        catch (...) {
+            const std::lock_guard lock{error_mutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+            // Make the other threads stop at their next chunk.
+            for (auto& b : best) {
+                b.store(std::numeric_limits<std::int64_t>::min());
+            }
+        }
+    }};
+
+    {
+        std::vector<std::jthread> others;
+        for (std::size_t t{1}; t < threads; t++) {
+            others.emplace_back(worker);
+        }
+        worker();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    std::array<std::int64_t, N> result;
+    for (std::size_t k{0}; k < N; k++) {
+        result[k] = best[k].load();
+    }
+    return result;
+}
+
+/// @brief Call `body(first, last)` on contiguous blocks which together cover
+/// `[0, count)`, one block per thread, and return when all are done.
+///
+/// Suits work which is already evenly spread over the indexes, such as one
+/// layer of a dynamic programming table.  An exception from any block is
+/// rethrown once every thread has finished.
+/// @param count Number of indexes.
+/// @param body Callable taking `std::size_t` bounds `[first, last)`, called
+/// concurrently on disjoint blocks.
+/// @param threads Number of threads to use, including the caller's.
+template <typename Body>
+void parallel_for(std::size_t count, Body body,
+                  std::size_t threads = worker_count())
+{
+    threads = std::max<std::size_t>(1, std::min(threads, count));
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto block{[&](std::size_t t) {
+        try {
+            body(count * t / threads, count * (t + 1) / threads);
+        }
+        catch (...) {
+            const std::lock_guard lock{error_mutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }};
+
+    {
+        std::vector<std::jthread> others;
+        for (std::size_t t{1}; t < threads; t++) {
+            others.emplace_back(block, t);
+        }
+        block(0);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace aoc
+
+#endif  // AOC_PARALLEL_HPP
@@ -0,0 +1,328 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_PARSE_HPP
+#define AOC_PARSE_HPP
+
+#include "aoc.hpp"
+#include "aoc_simd.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Parser combinators for the line-oriented puzzle inputs.  A grammar for a line
+// is declared once, as a constexpr object built from literals and typed fields,
+// for example:
+//
+//     constexpr auto grammar{(parse::lit("turn on ", light_action::on) |
+//                             parse::lit("turn off ", light_action::off)) +
+//                            parse::integer<int> + "," + parse::integer<int>};
+//     const auto [action, x, y]{parse::parse_line(grammar, line)};
+//
+// Parsing a line never allocates: every field is parsed in place, and text
+// fields are string_views into the line.  Each parser's `value_type` is a tuple
+// of the fields it produces; literals produce nothing, so a sequence's fields
+// are just the fields of its parts.  `parse_table` parses every line of an
+// input with one grammar into a `record_table`, one column per field.
+
+namespace aoc::parse {
+
+struct parser_base {};
+
+template <typename P>
+concept parser = std::derived_from<P, parser_base>;
+
+namespace detail {
+
+template <typename... Tuples>
+using tuple_cat_t = decltype(std::tuple_cat(std::declval<Tuples>()...));
+
+constexpr bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+}  // namespace detail
+
+// Append decimal digit `d` to `value`, returning false if the result would not
+// fit in `Number`.  Negative numbers are accumulated downward so that the
+// minimum value can be represented.
+template <typename Number>
+constexpr bool append_digit(Number& value, Number d, bool negative) noexcept
+{
+    constexpr Number max{std::numeric_limits<Number>::max()};
+    if constexpr (std::is_signed_v<Number>) {
+        constexpr Number min{std::numeric_limits<Number>::min()};
+        if (negative) {
+            if (value < static_cast<Number>((min + d) / 10)) {
+                return false;
+            }
+            value = static_cast<Number>(value * 10 - d);
+            return true;
+        }
+    }
+    if (value > static_cast<Number>((max - d) / 10)) {
+        return false;
+    }
+    value = static_cast<Number>(value * 10 + d);
+    return true;
+}
+
+// Exact text, producing nothing.
+struct literal : parser_base {
+    using value_type = std::tuple<>;
+    std::string_view text;
+
+    constexpr bool operator()(std::string_view& in, value_type&) const noexcept
+    {
+        if (!in.starts_with(text)) {
+            return false;
+        }
+        in.remove_prefix(text.size());
+        return true;
+    }
+};
+
+// Exact text, producing a fixed value; useful for keywords as alternatives.
+template <typename T>
+struct keyword : parser_base {
+    using value_type = std::tuple<T>;
+    std::string_view text;
+    T value;
+
+    constexpr bool operator()(std::string_view& in,
+                              value_type& out) const noexcept
+    {
+        if (!in.starts_with(text)) {
+            return false;
+        }
+        in.remove_prefix(text.size());
+        std::get<0>(out) = value;
+        return true;
+    }
+};
+
+constexpr literal lit(std::string_view text) noexcept
+{
+    return {{}, text};
+}
+
+template <typename T>
+constexpr keyword<T> lit(std::string_view text, T value) noexcept
+{
+    return {{}, text, value};
+}
+
+// Decimal integer, with a leading '-' if `Number` is signed.
+template <std::integral Number>
+struct integer_parser : parser_base {
+    using value_type = std::tuple<Number>;
+
+    constexpr bool operator()(std::string_view& in,
+                              value_type& out) const noexcept
+    {
+        std::size_t i{0};
+        bool negative{false};
+        if constexpr (std::is_signed_v<Number>) {
+            negative = !in.empty() && in[0] == '-';
+            i = negative ? 1 : 0;
+        }
+        if (i >= in.size() || !detail::is_digit(in[i])) {
+            return false;
+        }
+        Number value{0};
+        for (; i < in.size() && detail::is_digit(in[i]); i++) {
+            if (!append_digit(value, static_cast<Number>(in[i] - '0'),
+                              negative)) {
+                return false;
+            }
+        }
+        in.remove_prefix(i);
+        std::get<0>(out) = value;
+        return true;
+    }
+};
+
+template <std::integral Number>
+inline constexpr integer_parser<Number> integer{};
+
+// One or more characters other than spaces, producing a string_view.
+struct word_parser : parser_base {
+    using value_type = std::tuple<std::string_view>;
+
+    constexpr bool operator()(std::string_view& in,
+                              value_type& out) const noexcept
+    {
+        const std::size_t size{std::min(in.find(' '), in.size())};
+        if (size == 0) {
+            return false;
+        }
+        std::get<0>(out) = in.substr(0, size);
+        in.remove_prefix(size);
+        return true;
+    }
+};
+
+inline constexpr word_parser word{};
+
+// `First` followed by `Second`, producing the fields of both.
+template <parser First, parser Second>
+struct sequence : parser_base {
+    using value_type = detail::tuple_cat_t<typename First::value_type,
+                                           typename Second::value_type>;
+    First first;
+    Second second;
+
+    constexpr bool operator()(std::string_view& in, value_type& out) const
+    {
+        typename First::value_type first_out{};
+        typename Second::value_type second_out{};
+        if (!first(in, first_out) || !second(in, second_out)) {
+            return false;
+        }
+        out = std::tuple_cat(std::move(first_out), std::move(second_out));
+        return true;
+    }
+};
+
+// `First` or, if that fails, `Second`.  Both must produce the same fields.
+template <parser First, parser Second>
+    requires std::same_as<typename First::value_type,
+                          typename Second::value_type>
+struct alternative : parser_base {
+    using value_type = typename First::value_type;
+    First first;
+    Second second;
+
+    constexpr bool operator()(std::string_view& in, value_type& out) const
+    {
+        const std::string_view start{in};
+        if (first(in, out)) {
+            return true;
+        }
+        in = start;
+        return second(in, out);
+    }
+};
+
+template <parser First, parser Second>
+constexpr sequence<First, Second> operator+(First first, Second second)
+{
+    return {{}, first, second};
+}
+
+template <parser First>
+constexpr sequence<First, literal> operator+(First first, std::string_view text)
+{
+    return {{}, first, lit(text)};
+}
+
+template <parser Second>
+constexpr sequence<literal, Second> operator+(std::string_view text,
+                                              Second second)
+{
+    return {{}, lit(text), second};
+}
+
+template <parser First, parser Second>
+constexpr alternative<First, Second> operator|(First first, Second second)
+{
+    return {{}, first, second};
+}
+
+// Parse the whole of `line`, returning a tuple of the grammar's fields.
+// Throws input_error if the line doesn't match.
+template <parser Parser>
+constexpr typename Parser::value_type parse_line(const Parser& grammar,
+                                                 std::string_view line)
+{
+    typename Parser::value_type out{};
+    std::string_view rest{line};
+    if (!grammar(rest, out) || !rest.empty()) {
+        throw input_error{fmt::format("failed to parse input: {}", line)};
+    }
+    return out;
+}
+
+// Parse the whole of `line` into a `Record` initialized from the grammar's
+// fields, in order.
+template <typename Record, parser Parser>
+constexpr Record parse_record(const Parser& grammar, std::string_view line)
+{
+    return std::apply([](auto&&... fields) { return Record{fields...}; },
+                      parse_line(grammar, line));
+}
+
+template <typename Tuple>
+class record_table;
+
+// Parsed lines stored as a structure of arrays: one contiguous column per
+// field of the grammar.
+template <typename... Fields>
+class record_table<std::tuple<Fields...>> {
+   public:
+    std::size_t size() const noexcept
+    {
+        return std::get<0>(columns_).size();
+    }
+
+    template <std::size_t Index>
+    auto column() const noexcept
+    {
+        return std::span{std::get<Index>(columns_)};
+    }
+
+    void reserve(std::size_t size)
+    {
+        std::apply([&](auto&... columns) { (columns.reserve(size), ...); },
+                   columns_);
+    }
+
+    void push_back(const std::tuple<Fields...>& record)
+    {
+        [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+            (std::get<Index>(columns_).push_back(std::get<Index>(record)),
+             ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+   private:
+    std::tuple<std::vector<Fields>...> columns_;
+};
+
+// Parse every line of `input` into a record_table.  A trailing newline is
+// ignored, as with sv_lines.
+template <parser Parser>
+record_table<typename Parser::value_type> parse_table(const Parser& grammar,
+                                                      std::string_view input)
+{
+    static_assert(std::tuple_size_v<typename Parser::value_type> > 0,
+                  "grammar has no fields");
+
+    record_table<typename Parser::value_type> out;
+    out.reserve(count_equal(input, '\n') + 1);
+    while (!input.empty()) {
+        const std::size_t end{find_equal(input, '\n')};
+        out.push_back(parse_line(grammar, input.substr(0, end)));
+        input.remove_prefix(std::min(end + 1, input.size()));
+    }
+    return out;
+}
+
+}  // namespace aoc::parse
+
+#endif  // AOC_PARSE_HPP
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_PREFIX_SUM_HPP
+#define AOC_PREFIX_SUM_HPP
+
+#include "aoc_grid.hpp"
+#include "aoc_vec.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace aoc {
+
+/// @brief Summed-area table: after one pass over a grid, the sum of any
+/// rectangle of it can be found in constant time.
+/// @tparam Value Arithmetic type wide enough to hold the sum of the whole grid.
+template <typename Value>
+class prefix_sum_grid {
+   public:
+    /// @brief Build the table from a grid with contiguous rows (see
+    /// `row_span`).
+    template <typename Grid>
+    explicit prefix_sum_grid(const Grid& grid)
+        : width_{grid.width()},
+          height_{grid.height()},
+          sums_(static_cast<std::size_t>(width_ + 1) *
+                static_cast<std::size_t>(height_ + 1))
+    {
+        for (int y{0}; y < height_; y++) {
+            const auto row{row_span(grid, y)};
+            Value row_sum{};
+            for (int x{0}; x < width_; x++) {
+                row_sum += static_cast<Value>(row[static_cast<std::size_t>(x)]);
+                at(x + 1, y + 1) = at(x + 1, y) + row_sum;
+            }
+        }
+    }
+
+    int width() const noexcept { return width_; }
+    int height() const noexcept { return height_; }
+
+    /// @brief Sum of the cells within `r`, which must lie within the grid.
+    Value sum(const rect<int>& r) const noexcept
+    {
+        const int x0{r.base.x};
+        const int y0{r.base.y};
+        const int x1{r.base.x + r.dimensions.x};
+        const int y1{r.base.y + r.dimensions.y};
+        return at(x1, y1) - at(x0, y1) - at(x1, y0) + at(x0, y0);
+    }
+
+    /// @brief Sum of every cell in the grid.
+    Value total() const noexcept { return at(width_, height_); }
+
+   private:
+    int width_;
+    int height_;
+    // (width + 1) x (height + 1) table where (x, y) holds the sum of all cells
+    // above and to the left of cell (x, y) in the original grid.
+    std::vector<Value> sums_;
+
+    Value& at(int x, int y) noexcept
+    {
+        return sums_[static_cast<std::size_t>(y) *
+                         static_cast<std::size_t>(width_ + 1) +
+                     static_cast<std::size_t>(x)];
+    }
+
+    const Value& at(int x, int y) const noexcept
+    {
+        return sums_[static_cast<std::size_t>(y) *
+                         static_cast<std::size_t>(width_ + 1) +
+                     static_cast<std::size_t>(x)];
+    }
+};
+
+/// @brief 2D difference array: adding a value to every cell in a rectangle is
+/// a constant-time update of the rectangle's four corners, and a single
+/// prefix-sum pass at the end produces the value of every cell.  Only suitable
+/// for updates which commute, i.e. additions; an update like "set to zero"
+/// depends on the value of each cell and must be applied cell by cell.
+/// @tparam Value Arithmetic type of the cells.
+template <typename Value>
+class difference_grid {
+   public:
+    difference_grid(int width, int height)
+        : width_{width},
+          height_{height},
+          deltas_(static_cast<std::size_t>(width_ + 1) *
+                  static_cast<std::size_t>(height_ + 1))
+    {
+    }
+
+    int width() const noexcept { return width_; }
+    int height() const noexcept { return height_; }
+
+    /// @brief Add `delta` to every cell within `r`, which must lie within the
+    /// grid.
+    void add(const rect<int>& r, Value delta) noexcept
+    {
+        const int x0{r.base.x};
+        const int y0{r.base.y};
+        const int x1{r.base.x + r.dimensions.x};
+        const int y1{r.base.y + r.dimensions.y};
+        at(x0, y0) += delta;
+        at(x1, y0) -= delta;
+        at(x0, y1) -= delta;
+        at(x1, y1) += delta;
+    }
+
+    /// @brief Toggle every cell within `r`.  Each cell's final state is the
+    /// parity of its value (`value % 2`).
+    void toggle(const rect<int>& r) noexcept { add(r, Value{1}); }
+
+    /// @brief Apply all of the updates, producing the value of every cell.
+    dynamic_grid<Value> values() const
+    {
+        dynamic_grid<Value> out{width_, height_};
+        std::vector<Value> column_sums(static_cast<std::size_t>(width_));
+        for (int y{0}; y < height_; y++) {
+            const auto row{row_span(out, y)};
+            Value row_sum{};
+            for (int x{0}; x < width_; x++) {
+                row_sum += at(x, y);
+                auto& column_sum{column_sums[static_cast<std::size_t>(x)]};
+                column_sum += row_sum;
+                row[static_cast<std::size_t>(x)] = column_sum;
+            }
+        }
+        return out;
+    }
+
+    /// @brief Apply all of the updates and build a summed-area table of the
+    /// result, to answer rectangle-sum queries in constant time.
+    prefix_sum_grid<Value> prefix_sums() const
+    {
+        return prefix_sum_grid<Value>{values()};
+    }
+
+   private:
+    int width_;
+    int height_;
+    // One extra row and column so that updates touching the far edges of the
+    // grid need no bounds checks.
+    std::vector<Value> deltas_;
+
+    Value& at(int x, int y) noexcept
+    {
+        return deltas_[static_cast<std::size_t>(y) *
+                           static_cast<std::size_t>(width_ + 1) +
+                       static_cast<std::size_t>(x)];
+    }
+
+    const Value& at(int x, int y) const noexcept
+    {
+        return deltas_[static_cast<std::size_t>(y) *
+                           static_cast<std::size_t>(width_ + 1) +
+                       static_cast<std::size_t>(x)];
+    }
+};
+
+}  // namespace aoc
+
+#endif  // AOC_PREFIX_SUM_HPP
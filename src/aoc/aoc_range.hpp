@@ -9,6 +9,8 @@
 #define AOC_RANGE_HPP
 
 #include "aoc.hpp"
+#include "aoc_parse.hpp"
+#include "aoc_simd.hpp"
 
 // XXX In order to avoid build failures, do not include any range-v3 headers
 // directly in any file! Instead, include this header to ensure this warning is
@@ -22,8 +24,16 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <span>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace aoc {
@@ -59,21 +69,139 @@ auto sv(auto&& rng)
                             static_cast<std::size_t>(r::distance(rng))};
 }
 
+// Range of the pieces of a string_view between occurrences of a delimiter,
+// found with the SIMD search in aoc_simd.hpp.  Matches the behaviour of
+// rv::split: empty pieces between adjacent delimiters are kept, but a trailing
+// delimiter does not produce a final empty piece.
+class delimited_range : public r::view_interface<delimited_range> {
+   public:
+    class iterator {
+       public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(std::string_view s, char delim, std::size_t first) noexcept
+            : s_{s}, delim_{delim}, first_{first}
+        {
+            find_last();
+        }
+
+        std::string_view operator*() const noexcept
+        {
+            return s_.substr(first_, last_ - first_);
+        }
+
+        iterator& operator++() noexcept
+        {
+            first_ = std::min(last_ + 1, s_.size());
+            find_last();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto out{*this};
+            ++*this;
+            return out;
+        }
+
+        friend bool operator==(const iterator& lhs,
+                               const iterator& rhs) noexcept
+        {
+            return lhs.first_ == rhs.first_;
+        }
+
+       private:
+        std::string_view s_;
+        char delim_{};
+        std::size_t first_{0};  // Start of this piece; s_.size() at the end
+        std::size_t last_{0};   // End of this piece (exclusive)
+
+        void find_last() noexcept
+        {
+            last_ = first_ + find_equal(s_.substr(first_), delim_);
+        }
+    };
+
+    delimited_range() = default;
+    delimited_range(std::string_view s, char delim) noexcept
+        : s_{s}, delim_{delim}
+    {
+    }
+
+    iterator begin() const noexcept { return {s_, delim_, 0}; }
+    iterator end() const noexcept { return {s_, delim_, s_.size()}; }
+
+   private:
+    std::string_view s_;
+    char delim_{};
+};
+
+// A std::string passed as an rvalue.  Its characters are gone by the time a
+// range of string_views into it is read, so the splitters below refuse it.
+template <typename T>
+concept temporary_string = !std::is_lvalue_reference_v<T> &&
+                           std::is_same_v<std::remove_cvref_t<T>, std::string>;
+
 // Split a range by a delimiter into a range of string_views.
 // XXX In C++23, split_view can produce ranges that are directly convertable to
 // string_views, making this much simpler.
 auto sv_split_range(auto&& rng, char delim) noexcept
+    requires(!temporary_string<decltype(rng)>)
 {
-    return rng | rv::split(delim) |
-           rv::transform([&](auto&& r) { return sv(r); });
+    if constexpr (std::is_convertible_v<decltype(rng), std::string_view>) {
+        return delimited_range{rng, delim};
+    }
+    else {
+        return rng | rv::split(delim) |
+               rv::transform([&](auto&& r) { return sv(r); });
+    }
 }
 
 // Split a range of characters into a range of string_views by line.
 auto sv_lines(auto&& rng) noexcept
+    requires(!temporary_string<decltype(rng)>)
 {
-    return sv_split_range(rng, '\n');
+    return sv_split_range(std::forward<decltype(rng)>(rng), '\n');
 }
 
+// Every line of some input, found in one pass and then available by index.
+// Prefer this to `sv_lines(input) | r::to<std::vector>` when the lines are
+// needed in random order.
+class line_index {
+   public:
+    // Keeps a view of `input`, which must outlive the index.
+    explicit line_index(std::string_view input) : input_{input}
+    {
+        find_all_equal(input_, '\n', ends_);
+        // As with sv_lines, the last line needn't end with a newline.
+        if (!input_.empty() && input_.back() != '\n') {
+            ends_.push_back(input_.size());
+        }
+    }
+
+    std::size_t size() const noexcept { return ends_.size(); }
+
+    // Offset of the start of line `i` within the input.
+    std::size_t offset(std::size_t i) const noexcept
+    {
+        return i == 0 ? 0 : ends_[i - 1] + 1;
+    }
+
+    std::string_view operator[](std::size_t i) const noexcept
+    {
+        return input_.substr(offset(i), ends_[i] - offset(i));
+    }
+
+   private:
+    std::string_view input_;
+    std::vector<std::size_t> ends_;  // Offset of the newline ending each line
+};
+
 auto sv_words(auto&& rng) noexcept
 {
     return rng | rv::split_when(is_whitespace) |
@@ -86,16 +214,175 @@ auto int_lines(auto&& rng) noexcept
     return sv_lines(rng) | rv::transform(to_int);
 }
 
+// Range of the integers in a string_view, separated by any other characters.
+// For signed types, a '-' immediately before a number is its sign, unless the
+// '-' follows another number ("1-2" is 1 and 2, but "x=-2" is -2); for
+// unsigned types it is just another separator.
+template <typename Number>
+class number_range : public r::view_interface<number_range<Number>> {
+    static_assert(std::is_integral_v<Number>);
+
+   public:
+    class iterator {
+       public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Number;
+        using difference_type = std::ptrdiff_t;
+        using reference = Number;
+
+        iterator() = default;
+        explicit iterator(std::string_view s) : s_{s}, next_{0} { scan(); }
+
+        Number operator*() const noexcept { return value_; }
+
+        iterator& operator++()
+        {
+            scan();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto out{*this};
+            ++*this;
+            return out;
+        }
+
+        friend bool operator==(const iterator& lhs,
+                               const iterator& rhs) noexcept
+        {
+            return lhs.next_ == rhs.next_;
+        }
+
+       private:
+        static constexpr std::size_t npos{std::string_view::npos};
+
+        std::string_view s_;
+        std::size_t next_{npos};  // Just past this number; npos at the end
+        Number value_{};
+
+        static constexpr bool digit(char c) noexcept
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        void scan()
+        {
+            std::size_t i{next_};
+            for (; i < s_.size(); i++) {
+                if (digit(s_[i])) {
+                    break;
+                }
+                if constexpr (std::is_signed_v<Number>) {
+                    if (s_[i] == '-' && i + 1 < s_.size() &&
+                        digit(s_[i + 1]) && (i == 0 || !digit(s_[i - 1]))) {
+                        break;
+                    }
+                }
+            }
+            if (i >= s_.size()) {
+                next_ = npos;
+                return;
+            }
+
+            const std::size_t first{i};
+            const bool negative{s_[i] == '-'};
+            if (negative) {
+                i++;
+            }
+            Number value{0};
+            for (; i < s_.size() && digit(s_[i]); i++) {
+                const auto d{static_cast<Number>(s_[i] - '0')};
+                if (!parse::append_digit(value, d, negative)) {
+                    throw input_error{
+                        fmt::format("number out of range: {}",
+                                    s_.substr(first, i + 1 - first))};
+                }
+            }
+            value_ = value;
+            next_ = i;
+        }
+    };
+
+    number_range() = default;
+    explicit number_range(std::string_view s) noexcept : s_{s} {}
+
+    iterator begin() const { return iterator{s_}; }
+    iterator end() const noexcept { return {}; }
+
+   private:
+    std::string_view s_;
+};
+
 // Split a range of characters into a range of ints separated by any non-digit
 // characters
-// FIXME: Should only allow '-' at the beginning of a number, not anywhere
 template <typename Number>
 auto numbers(auto&& rng)
+    requires(!temporary_string<decltype(rng)>)
+{
+    return number_range<Number>{std::string_view{rng}};
+}
+
+// Lines of `Columns` integers each, stored as `Columns` contiguous columns so
+// that per-column work can run over flat arrays.  Built in two passes: one to
+// count the lines, so that the storage is allocated once at its exact size,
+// and one to parse the numbers straight into place.
+template <typename Number, std::size_t Columns>
+class number_columns {
+   public:
+    // Throws input_error if any line doesn't contain exactly `Columns`
+    // numbers.
+    explicit number_columns(std::string_view input)
+    {
+        rows_ = count_equal(input, '\n');
+        if (!input.empty() && input.back() != '\n') {
+            rows_++;
+        }
+        data_.resize(rows_ * Columns);
+
+        std::size_t row{0};
+        for (const std::string_view line : delimited_range{input, '\n'}) {
+            std::size_t column{0};
+            for (const Number n : number_range<Number>{line}) {
+                if (column < Columns) {
+                    data_[column * rows_ + row] = n;
+                }
+                column++;
+            }
+            if (column != Columns) {
+                throw input_error{fmt::format(
+                    "expected {} numbers on line: {}", Columns, line)};
+            }
+            row++;
+        }
+    }
+
+    std::size_t rows() const noexcept { return rows_; }
+
+    std::span<const Number> column(std::size_t c) const noexcept
+    {
+        return std::span{data_}.subspan(c * rows_, rows_);
+    }
+
+    std::array<Number, Columns> row(std::size_t r) const noexcept
+    {
+        std::array<Number, Columns> out;
+        for (std::size_t c{0}; c < Columns; c++) {
+            out[c] = data_[c * rows_ + r];
+        }
+        return out;
+    }
+
+   private:
+    std::size_t rows_{0};
+    std::vector<Number> data_;
+};
+
+template <typename Number, std::size_t Columns>
+number_columns<Number, Columns> parse_columns(std::string_view input)
 {
-    auto is_not_digit = [](char c) { return !is_digit(c) && (c != '-'); };
-    return rng | rv::split_when(is_not_digit) |
-           rv::transform([](auto&& r) { return sv(r); }) | rv::remove("") |
-           rv::remove("-") | rv::transform(to_num<Number>);
+    return number_columns<Number, Columns>{input};
 }
 
 int bool_range_to_int(auto&& bits)
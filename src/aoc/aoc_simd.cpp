@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "aoc_simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AOC_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_SIMD_SSE2
+#endif
+
+namespace aoc {
+
+namespace {
+
+// Each block is compared as a whole and reduced to a bitmask with one bit per
+// byte, set where the bytes compared equal.
+#if defined(AOC_SIMD_AVX2)
+constexpr std::size_t block_size{32};
+using block_mask = std::uint32_t;
+constexpr block_mask full_mask{0xFFFFFFFFu};
+
+block_mask eq_mask(const char* a, char c) noexcept
+{
+    const __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a))};
+    const __m256i cmp{_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))};
+    return static_cast<block_mask>(_mm256_movemask_epi8(cmp));
+}
+
+block_mask eq_mask(const char* a, const char* b) noexcept
+{
+    const __m256i va{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a))};
+    const __m256i vb{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b))};
+    return static_cast<block_mask>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+}
+#elif defined(AOC_SIMD_SSE2)
+constexpr std::size_t block_size{16};
+using block_mask = std::uint32_t;
+constexpr block_mask full_mask{0xFFFFu};
+
+block_mask eq_mask(const char* a, char c) noexcept
+{
+    const __m128i v{_mm_loadu_si128(reinterpret_cast<const __m128i*>(a))};
+    const __m128i cmp{_mm_cmpeq_epi8(v, _mm_set1_epi8(c))};
+    return static_cast<block_mask>(_mm_movemask_epi8(cmp));
+}
+
+block_mask eq_mask(const char* a, const char* b) noexcept
+{
+    const __m128i va{_mm_loadu_si128(reinterpret_cast<const __m128i*>(a))};
+    const __m128i vb{_mm_loadu_si128(reinterpret_cast<const __m128i*>(b))};
+    return static_cast<block_mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+}
+#else
+// SWAR fallback: eight bytes per step in a 64-bit word.  Bytes which compare
+// equal become zero after the XOR; the mask gathers one bit per zero byte.
+constexpr std::size_t block_size{8};
+using block_mask = std::uint32_t;
+constexpr block_mask full_mask{0xFFu};
+
+std::uint64_t load_word(const char* p) noexcept
+{
+    std::uint64_t w{0};
+    for (std::size_t i{0}; i < block_size; i++) {
+        w |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+    }
+    return w;
+}
+
+block_mask zero_byte_mask(std::uint64_t x) noexcept
+{
+    constexpr std::uint64_t low7{0x7F7F7F7F7F7F7F7Full};
+    // High bit of each byte is set iff that byte of `x` is nonzero.
+    const std::uint64_t nonzero{((x & low7) + low7) | x};
+    block_mask out{0};
+    for (std::size_t i{0}; i < block_size; i++) {
+        out |= static_cast<block_mask>(((nonzero >> (8 * i + 7)) & 1) ^ 1)
+               << i;
+    }
+    return out;
+}
+
+block_mask eq_mask(const char* a, char c) noexcept
+{
+    const std::uint64_t splat{0x0101010101010101ull *
+                              static_cast<unsigned char>(c)};
+    return zero_byte_mask(load_word(a) ^ splat);
+}
+
+block_mask eq_mask(const char* a, const char* b) noexcept
+{
+    return zero_byte_mask(load_word(a) ^ load_word(b));
+}
+#endif
+
+}  // namespace
+
+std::size_t count_equal(std::span<const char> s, char c) noexcept
+{
+    std::size_t count{0};
+    std::size_t i{0};
+    for (; i + block_size <= s.size(); i += block_size) {
+        count += static_cast<std::size_t>(std::popcount(eq_mask(&s[i], c)));
+    }
+    return count + static_cast<std::size_t>(
+                       std::count(s.begin() + static_cast<std::ptrdiff_t>(i),
+                                  s.end(), c));
+}
+
+bool all_equal(std::span<const char> s, char c) noexcept
+{
+    std::size_t i{0};
+    for (; i + block_size <= s.size(); i += block_size) {
+        if (eq_mask(&s[i], c) != full_mask) {
+            return false;
+        }
+    }
+    return std::all_of(s.begin() + static_cast<std::ptrdiff_t>(i), s.end(),
+                       [c](char x) { return x == c; });
+}
+
+bool any_equal(std::span<const char> s, char c) noexcept
+{
+    std::size_t i{0};
+    for (; i + block_size <= s.size(); i += block_size) {
+        if (eq_mask(&s[i], c) != 0) {
+            return true;
+        }
+    }
+    return std::find(s.begin() + static_cast<std::ptrdiff_t>(i), s.end(), c) !=
+           s.end();
+}
+
+std::size_t find_equal(std::span<const char> s, char c) noexcept
+{
+    std::size_t i{0};
+    for (; i + block_size <= s.size(); i += block_size) {
+        if (const block_mask mask{eq_mask(&s[i], c)}; mask != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    for (; i < s.size(); i++) {
+        if (s[i] == c) {
+            return i;
+        }
+    }
+    return s.size();
+}
+
+void find_all_equal(std::span<const char> s,
+                    char c,
+                    std::vector<std::size_t>& out)
+{
+    std::size_t i{0};
+    for (; i + block_size <= s.size(); i += block_size) {
+        // Peel off one set bit (one match) at a time, lowest first.
+        for (block_mask mask{eq_mask(&s[i], c)}; mask != 0; mask &= mask - 1) {
+            out.push_back(i + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+    }
+    for (; i < s.size(); i++) {
+        if (s[i] == c) {
+            out.push_back(i);
+        }
+    }
+}
+
+std::size_t count_mismatches(std::span<const char> a,
+                             std::span<const char> b) noexcept
+{
+    const std::size_t size{std::min(a.size(), b.size())};
+    std::size_t count{0};
+    std::size_t i{0};
+    for (; i + block_size <= size; i += block_size) {
+        count += static_cast<std::size_t>(
+            std::popcount(~eq_mask(&a[i], &b[i]) & full_mask));
+    }
+    for (; i < size; i++) {
+        count += (a[i] != b[i]) ? 1u : 0u;
+    }
+    return count;
+}
+
+}  // namespace aoc
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_SIMD_HPP
+#define AOC_SIMD_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Reductions and searches over contiguous runs of bytes.  These use SSE2 (or
+// AVX2, if the compiler is targeting it) to process 16 (or 32) bytes per step,
+// with a scalar loop for the leftover tail.  They are the building blocks for
+// the grid row/column operations in aoc_grid.hpp and the line splitting in
+// aoc_range.hpp, which is where most callers should start.
+
+// Number of bytes in `s` equal to `c`.
+std::size_t count_equal(std::span<const char> s, char c) noexcept;
+
+// True if every byte in `s` is equal to `c` (or `s` is empty).
+bool all_equal(std::span<const char> s, char c) noexcept;
+
+// True if any byte in `s` is equal to `c`.
+bool any_equal(std::span<const char> s, char c) noexcept;
+
+// Index of the first byte in `s` equal to `c`, or `s.size()` if there is none.
+std::size_t find_equal(std::span<const char> s, char c) noexcept;
+
+// Append the index of every byte in `s` equal to `c` to `out`, in order.
+void find_all_equal(std::span<const char> s,
+                    char c,
+                    std::vector<std::size_t>& out);
+
+// Number of positions at which `a` and `b` differ (the Hamming distance).  Only
+// the first min(a.size(), b.size()) positions are compared.
+std::size_t count_mismatches(std::span<const char> a,
+                             std::span<const char> b) noexcept;
+
+}  // namespace aoc
+
+#endif  // AOC_SIMD_HPP
@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "aoc_subset_sum.hpp"
+
+#include <array>
+#include <limits>
+#include <numeric>
+
+namespace aoc::subset_sum {
+
+std::vector<std::uint64_t> count_by_size(std::span<const int> items,
+                                         int target)
+{
+    if (target < 0 ||
+        std::ranges::any_of(items, [](int i) { return i < 0; })) {
+        throw input_error{"subset counts need non-negative items and target"};
+    }
+
+    // ways[k * width + s]: subsets of the items so far with `k` items and sum
+    // `s`, starting from just the empty one.  Each item is added with `k` and
+    // `s` running downward, so that it is only counted once per subset.
+    const auto width{static_cast<std::size_t>(target) + 1};
+    std::vector<std::uint64_t> ways{1};
+    ways.resize((items.size() + 1) * width);
+    for (std::size_t n{0}; n < items.size(); n++) {
+        const auto item{static_cast<std::size_t>(items[n])};
+        if (item >= width) {
+            continue;
+        }
+        for (std::size_t k{n + 1}; k > 0; k--) {
+            for (std::size_t s{width}; s-- > item;) {
+                ways[k * width + s] += ways[(k - 1) * width + s - item];
+            }
+        }
+    }
+
+    std::vector<std::uint64_t> counts(items.size() + 1);
+    for (std::size_t k{0}; k <= items.size(); k++) {
+        counts[k] = ways[k * width + width - 1];
+    }
+    return counts;
+}
+
+namespace {
+
+// Depth-first searches over the items sorted largest first, so that sums
+// overshoot early and the bounds below prune most of the tree.
+class group_search {
+   public:
+    group_search(std::span<const int> items, std::int64_t target)
+        : size_{items.size()}, target_{target}
+    {
+        for (std::size_t i{0}; i < size_; i++) {
+            order_[i] = i;
+        }
+        std::sort(order_.begin(), order_.begin() + size_,
+                  [&items](std::size_t a, std::size_t b) {
+                      return items[a] > items[b];
+                  });
+        for (std::size_t i{0}; i < size_; i++) {
+            weights_[i] = items[order_[i]];
+            largest_sums_[i + 1] = largest_sums_[i] + weights_[i];
+        }
+    }
+
+    // The best group of exactly `size` items, if any, into `best_`.
+    bool find(std::size_t size)
+    {
+        pick(0, size, target_, 0, 1);
+        return best_.has_value();
+    }
+
+    group best() const
+    {
+        group out{*best_};
+        // Back from sorted positions to the caller's.
+        mask_t members{0};
+        for (auto m{out.members}; m != 0; m &= m - 1) {
+            const auto i{static_cast<std::size_t>(std::countr_zero(m))};
+            members |= mask_t{1} << order_[i];
+        }
+        out.members = members;
+        return out;
+    }
+
+   private:
+    static constexpr std::uint64_t overflow{
+        std::numeric_limits<std::uint64_t>::max()};
+
+    std::size_t size_;
+    std::int64_t target_;
+    std::array<std::size_t, max_items> order_{};
+    std::array<std::int64_t, max_items> weights_{};
+    // Prefix sums of the sorted weights: largest_sums_[i] is the sum of the
+    // largest `i` items, so the sum of the items in [a, b) is
+    // largest_sums_[b] - largest_sums_[a].
+    std::array<std::int64_t, max_items + 1> largest_sums_{};
+    std::optional<group> best_;
+
+    void pick(std::size_t next, std::size_t left, std::int64_t remaining,
+              mask_t members, std::uint64_t product)
+    {
+        // Every item is at least 1, so products only grow.
+        if (best_ && product >= best_->product) {
+            return;
+        }
+        if (left == 0) {
+            const auto all{size_ == max_items ? ~mask_t{0}
+                                              : (mask_t{1} << size_) - 1};
+            if (remaining == 0 && splits(all & ~members)) {
+                const auto size{
+                    static_cast<std::size_t>(std::popcount(members))};
+                best_ = group{members, size, product};
+            }
+            return;
+        }
+        // Even the smallest items left would overshoot.
+        if (left > size_ ||
+            remaining < largest_sums_[size_] - largest_sums_[size_ - left]) {
+            return;
+        }
+        for (std::size_t i{next}; i + left <= size_; i++) {
+            // Later items are smaller, so if the largest ones left fall
+            // short, so will any others.
+            if (remaining > largest_sums_[i + left] - largest_sums_[i]) {
+                return;
+            }
+            if (weights_[i] > remaining) {
+                continue;
+            }
+            const auto weight{static_cast<std::uint64_t>(weights_[i])};
+            const auto next_product{
+                product > overflow / weight ? overflow : product * weight};
+            pick(i + 1, left - 1, remaining - weights_[i],
+                 members | mask_t{1} << i, next_product);
+        }
+    }
+
+    // Whether the items in `available`, which sum to a multiple of the
+    // target, split into groups of the target.  The largest available item
+    // has to be in some group, so only groups holding it are tried.
+    bool splits(mask_t available) const
+    {
+        if (available == 0) {
+            return true;
+        }
+        const auto first{
+            static_cast<std::size_t>(std::countr_zero(available))};
+        return fill_group(available & ~(mask_t{1} << first), first + 1,
+                          target_ - weights_[first], mask_t{1} << first,
+                          available);
+    }
+
+    bool fill_group(mask_t candidates, std::size_t next,
+                    std::int64_t remaining, mask_t members,
+                    mask_t available) const
+    {
+        if (remaining == 0) {
+            return splits(available & ~members);
+        }
+        const mask_t later{next < max_items ? ~mask_t{0} << next : 0};
+        for (auto m{candidates & later}; m != 0; m &= m - 1) {
+            const auto i{static_cast<std::size_t>(std::countr_zero(m))};
+            if (weights_[i] <= remaining &&
+                fill_group(candidates, i + 1, remaining - weights_[i],
+                           members | mask_t{1} << i, available)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+}  // namespace
+
+std::optional<group> smallest_group(std::span<const int> items,
+                                    std::size_t group_count)
+{
+    if (items.size() > max_items) {
+        throw input_error{
+            fmt::format("too many items for subset masks: {}", items.size())};
+    }
+    if (std::ranges::any_of(items, [](int i) { return i <= 0; })) {
+        throw input_error{"group items must be positive"};
+    }
+    const auto total{std::accumulate(items.begin(), items.end(),
+                                     std::int64_t{0})};
+    if (group_count == 0 ||
+        total % static_cast<std::int64_t>(group_count) != 0) {
+        return std::nullopt;
+    }
+
+    group_search search{items, total / static_cast<std::int64_t>(group_count)};
+    for (std::size_t size{1}; size <= items.size(); size++) {
+        if (search.find(size)) {
+            const auto found{search.best()};
+            if (found.product == std::numeric_limits<std::uint64_t>::max()) {
+                throw solution_error{"group product overflows"};
+            }
+            return found;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace aoc::subset_sum
@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_SUBSET_SUM_HPP
+#define AOC_SUBSET_SUM_HPP
+
+#include "aoc.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Searches over the subsets of a list of integer items, for the puzzles which
+// pick containers, packages and the like to reach an exact total.
+//
+// - `count_by_size` counts the subsets hitting a total by dynamic programming
+//   over the totals, without looking at any subset.
+// - `for_each_subset` visits every subset in Gray code order, so each subset's
+//   sum is the previous one's plus or minus a single item.
+// - `for_each_with_sum` visits just the subsets hitting a total by meeting in
+//   the middle: the sums of each half of the items are enumerated separately
+//   and matched up, which is `2^(n/2)` work rather than `2^n`.
+// - `smallest_group` finds the fewest items, and among those the smallest
+//   product, which make up one of several equal groups.
+//
+// Subsets are passed around as masks, bit `i` standing for `items[i]`, so
+// visiting them allocates nothing.
+
+namespace aoc::subset_sum {
+
+using mask_t = std::uint64_t;
+
+/// @brief Most items a subset mask can hold.
+inline constexpr std::size_t max_items{64};
+
+/// @brief Entry `k` is the number of subsets of exactly `k` of the items whose
+/// sum is `target`.  Items and target must not be negative.
+std::vector<std::uint64_t> count_by_size(std::span<const int> items,
+                                         int target);
+
+/// @brief Call `visit(mask, sum)` for every subset of `items`, starting with
+/// the empty one, in Gray code order.  Allows fewer than 64 items.
+template <typename Visit>
+void for_each_subset(std::span<const int> items, Visit visit)
+{
+    if (items.size() >= max_items) {
+        throw input_error{
+            fmt::format("too many items to enumerate: {}", items.size())};
+    }
+    mask_t mask{0};
+    std::int64_t sum{0};
+    visit(mask, sum);
+    const mask_t count{mask_t{1} << items.size()};
+    for (mask_t step{1}; step < count; step++) {
+        const auto i{static_cast<std::size_t>(std::countr_zero(step))};
+        mask ^= mask_t{1} << i;
+        sum += (mask >> i & 1) != 0 ? items[i] : -items[i];
+        visit(mask, sum);
+    }
+}
+
+/// @brief Call `visit(mask)` for every subset of `items` whose sum is `target`,
+/// in no particular order.  Up to 64 items, though the work and the table of
+/// the first half's sums double for every two more.
+template <typename Visit>
+void for_each_with_sum(std::span<const int> items, std::int64_t target,
+                       Visit visit)
+{
+    if (items.size() > max_items) {
+        throw input_error{
+            fmt::format("too many items for subset masks: {}", items.size())};
+    }
+    const std::size_t half{items.size() / 2};
+
+    std::vector<std::pair<std::int64_t, mask_t>> first_sums;
+    first_sums.reserve(std::size_t{1} << half);
+    for_each_subset(items.first(half), [&](mask_t mask, std::int64_t sum) {
+        first_sums.emplace_back(sum, mask);
+    });
+    std::ranges::sort(first_sums);
+
+    for_each_subset(items.subspan(half), [&](mask_t mask, std::int64_t sum) {
+        const auto want{target - sum};
+        auto match{std::ranges::lower_bound(
+            first_sums, want, {},
+            &std::pair<std::int64_t, mask_t>::first)};
+        for (; match != first_sums.end() && match->first == want; ++match) {
+            visit(match->second | mask << half);
+        }
+    });
+}
+
+/// @brief One group of a split of the items into equal sums.
+struct group {
+    mask_t members;
+    std::size_t size;
+    std::uint64_t product;
+};
+
+/// @brief Of the ways to split `items` into `group_count` groups of equal sum,
+/// the group with the fewest items, and of those the smallest product, or
+/// nothing if they can't be split.
+///
+/// Sizes are tried from the smallest up, so only candidates of the smallest
+/// size which has any are checked to see whether the other items split evenly
+/// too.  Items must be positive; throws `aoc::solution_error` if the smallest
+/// product doesn't fit in 64 bits.
+std::optional<group> smallest_group(std::span<const int> items,
+                                    std::size_t group_count);
+
+}  // namespace aoc::subset_sum
+
+#endif  // AOC_SUBSET_SUM_HPP
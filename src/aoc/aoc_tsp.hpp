@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef AOC_TSP_HPP
+#define AOC_TSP_HPP
+
+#include "aoc.hpp"
+#include "aoc_parallel.hpp"
+
+#include <fmt/format.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace aoc::tsp {
+
+/// @brief Whether a route returns to where it started.
+enum class route { path, cycle };
+
+/// @brief Whether the best route is the cheapest or the dearest.
+enum class objective { minimize, maximize };
+
+/// @brief Largest number of nodes accepted.  The table for `n` nodes holds
+/// `2^n * n` costs, which is already 160MB of 64-bit costs at this limit.
+inline constexpr std::size_t max_nodes{20};
+
+/// @brief Cost of travelling between each pair of `n` nodes, stored densely.
+/// Costs may be asymmetric and default to zero.
+template <typename Cost>
+class distance_matrix {
+   public:
+    explicit distance_matrix(std::size_t n) : n_{n}, costs_(n * n) {}
+
+    std::size_t size() const noexcept { return n_; }
+
+    Cost& operator()(std::size_t from, std::size_t to) noexcept
+    {
+        return costs_[from * n_ + to];
+    }
+    Cost operator()(std::size_t from, std::size_t to) const noexcept
+    {
+        return costs_[from * n_ + to];
+    }
+
+   private:
+    std::size_t n_;
+    std::vector<Cost> costs_;
+};
+
+namespace detail {
+
+// Held-Karp over the nodes `[0, m)`: `best[mask * m + j]` is the best cost of a
+// path which visits exactly the nodes in `mask` and ends at `j`, given the
+// costs of the single-node paths.  A path's cost only depends on its set of
+// nodes and its end, so each entry needs just the entries of the mask without
+// `j`, and the masks are filled a layer at a time, by number of nodes.  The
+// masks of a layer are independent, so a large layer is split across threads.
+template <typename Cost, typename Better>
+void fill_table(const distance_matrix<Cost>& d, std::size_t m,
+                std::vector<Cost>& best, std::size_t threads)
+{
+    const std::size_t full{(std::size_t{1} << m) - 1};
+    // Where each search for a best cost starts: anything beats it.
+    constexpr Cost worst{Better{}(0, 1) ? std::numeric_limits<Cost>::max()
+                                        : std::numeric_limits<Cost>::lowest()};
+
+    // Every mask, ordered by number of nodes.
+    std::vector<std::uint32_t> layer_start(m + 2);
+    for (std::size_t mask{0}; mask <= full; mask++) {
+        layer_start[static_cast<std::size_t>(std::popcount(mask)) + 1]++;
+    }
+    std::partial_sum(layer_start.begin(), layer_start.end(),
+                     layer_start.begin());
+    std::vector<std::uint32_t> masks(full + 1);
+    {
+        auto next{layer_start};
+        for (std::size_t mask{0}; mask <= full; mask++) {
+            const auto layer{static_cast<std::size_t>(std::popcount(mask))};
+            masks[next[layer]++] = static_cast<std::uint32_t>(mask);
+        }
+    }
+
+    const auto fill{[&](std::size_t first, std::size_t last) {
+        for (std::size_t k{first}; k < last; k++) {
+            const std::size_t mask{masks[k]};
+            for (auto ends{mask}; ends != 0; ends &= ends - 1) {
+                const auto j{static_cast<std::size_t>(std::countr_zero(ends))};
+                const std::size_t rest{mask ^ (std::size_t{1} << j)};
+                Cost found{worst};
+                for (auto prevs{rest}; prevs != 0; prevs &= prevs - 1) {
+                    const auto i{
+                        static_cast<std::size_t>(std::countr_zero(prevs))};
+                    const Cost cost{best[rest * m + i] + d(i, j)};
+                    if (Better{}(cost, found)) {
+                        found = cost;
+                    }
+                }
+                best[mask * m + j] = found;
+            }
+        }
+    }};
+
+    // Below this many entries to update, starting threads costs more than
+    // they save.
+    constexpr std::size_t min_parallel_work{std::size_t{1} << 16};
+    for (std::size_t layer{2}; layer <= m; layer++) {
+        const std::size_t first{layer_start[layer]};
+        const std::size_t count{layer_start[layer + 1] - first};
+        const auto block{[&](std::size_t begin, std::size_t end) {
+            fill(first + begin, first + end);
+        }};
+        if (threads > 1 && count * layer * layer >= min_parallel_work) {
+            parallel_for(count, block, threads);
+        }
+        else {
+            block(0, count);
+        }
+    }
+}
+
+template <typename Cost, typename Better>
+Cost solve(const distance_matrix<Cost>& d, route kind, std::size_t threads)
+{
+    const std::size_t n{d.size()};
+    if (n == 0) {
+        return Cost{};
+    }
+    if (n > max_nodes) {
+        throw input_error{fmt::format(
+            "TSP with {} nodes is too large, the limit is {}", n, max_nodes)};
+    }
+
+    // A cycle can start anywhere, so it starts at the last node, leaving the
+    // rest for the table; a path starts at any node for free.
+    const std::size_t m{kind == route::cycle ? n - 1 : n};
+    if (m == 0) {
+        return d(0, 0);
+    }
+    const std::size_t full{(std::size_t{1} << m) - 1};
+    std::vector<Cost> best((full + 1) * m);
+    for (std::size_t j{0}; j < m; j++) {
+        best[(std::size_t{1} << j) * m + j] =
+            kind == route::cycle ? d(n - 1, j) : Cost{};
+    }
+    fill_table<Cost, Better>(d, m, best, threads);
+
+    Cost result{best[full * m]};
+    for (std::size_t j{0}; j < m; j++) {
+        Cost cost{best[full * m + j]};
+        if (kind == route::cycle) {
+            cost += d(j, n - 1);
+        }
+        if (j == 0 || Better{}(cost, result)) {
+            result = cost;
+        }
+    }
+    return result;
+}
+
+}  // namespace detail
+
+/// @brief Best cost of a route visiting every node of `d` once, by Held-Karp
+/// dynamic programming in `O(2^n * n^2)` time and `O(2^n * n)` space.
+///
+/// Throws `aoc::input_error` for more than `max_nodes` nodes.
+/// @param d Costs between the nodes.
+/// @param kind A path may start and end anywhere; a cycle returns to its
+/// start, adding the cost of that last step.
+/// @param goal Whether to find the cheapest or dearest route.
+/// @param threads Number of threads to fill large layers of the table on.
+template <typename Cost>
+Cost solve(const distance_matrix<Cost>& d, route kind, objective goal,
+           std::size_t threads = 1)
+{
+    if (goal == objective::minimize) {
+        return detail::solve<Cost, std::less<>>(d, kind, threads);
+    }
+    return detail::solve<Cost, std::greater<>>(d, kind, threads);
+}
+
+}  // namespace aoc::tsp
+
+#endif  // AOC_TSP_HPP
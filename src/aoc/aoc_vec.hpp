@@ -9,12 +9,15 @@
 #define AOC_VEC_HPP
 
 #include "aoc.hpp"
+#include "aoc_hash.hpp"
 #include "aoc_range.hpp"
 
 #include <fmt/format.h>
 
 #include <compare>
+#include <cstdint>
 #include <functional>
+#include <type_traits>
 
 namespace aoc {
 
@@ -166,13 +169,34 @@ vec3<Scalar> vec_from_strings(std::string_view x,
 
 }  // namespace aoc
 
+namespace aoc::detail {
+
+// Neighbouring points differ only in the low bits of each coordinate, so the
+// coordinates are packed into one word (or combined, if they are too wide) and
+// mixed until every bit of the result depends on all of them.
+template <typename Scalar>
+std::uint64_t hash_coords(Scalar x, Scalar y) noexcept
+{
+    if constexpr (std::is_integral_v<Scalar> && sizeof(Scalar) <= 4) {
+        using unsigned_type = std::make_unsigned_t<Scalar>;
+        const std::uint64_t packed{
+            (std::uint64_t{static_cast<unsigned_type>(x)} << 32) |
+            std::uint64_t{static_cast<unsigned_type>(y)}};
+        return fmix64(packed);
+    }
+    else {
+        return hash_combine(fmix64(std::hash<Scalar>{}(x)),
+                            std::hash<Scalar>{}(y));
+    }
+}
+
+}  // namespace aoc::detail
+
 template <typename Scalar>
 struct std::hash<aoc::vec2<Scalar>> {
     std::size_t operator()(const aoc::vec2<Scalar>& v) const noexcept
     {
-        std::size_t h1 = std::hash<Scalar>{}(v.x);
-        std::size_t h2 = std::hash<Scalar>{}(v.y);
-        return h1 ^ (h2 << 1);
+        return static_cast<std::size_t>(aoc::detail::hash_coords(v.x, v.y));
     }
 };
 
@@ -180,11 +204,8 @@ template <typename Scalar>
 struct std::hash<aoc::vec3<Scalar>> {
     std::size_t operator()(const aoc::vec3<Scalar>& v) const noexcept
     {
-        // XXX This is not a great hash function
-        std::size_t h1 = std::hash<Scalar>{}(v.x);
-        std::size_t h2 = std::hash<Scalar>{}(v.y);
-        std::size_t h3 = std::hash<Scalar>{}(v.z);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
+        return static_cast<std::size_t>(aoc::detail::hash_combine(
+            aoc::detail::hash_coords(v.x, v.y), std::hash<Scalar>{}(v.z)));
     }
 };
 
@@ -0,0 +1,481 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aoc {
+
+// Vector which stores up to `N` elements inside itself and moves them to the
+// heap only when it grows beyond that.  This is for functions such as graph
+// adjacencies which return a handful of elements per call: returning a
+// small_vector costs no allocation as long as the result fits.
+//
+// Unlike tiny_vector this holds any type and never refuses to grow.  Elements
+// of trivially copyable types are relocated with memcpy when the storage moves.
+//
+// Moving a small_vector whose elements are stored inline moves the elements
+// themselves, so unlike std::vector, iterators into the source are not valid
+// iterators into the destination.
+template <typename T, std::size_t N>
+class small_vector {
+    static_assert(N > 0, "small_vector must have some inline capacity");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // True if moving an element is equivalent to copying its bytes.
+    static constexpr bool trivially_relocatable{
+        std::is_trivially_copyable_v<T>};
+
+    small_vector() noexcept {}
+
+    explicit small_vector(size_type count) { resize(count); }
+
+    small_vector(size_type count, const T& value) { assign(count, value); }
+
+    template <std::input_iterator InputIt>
+    small_vector(InputIt first, InputIt last)
+    {
+        assign(first, last);
+    }
+
+    small_vector(std::initializer_list<T> init) { assign(init); }
+
+    small_vector(const small_vector& other)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    small_vector(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        take(other);
+    }
+
+    ~small_vector() noexcept
+    {
+        clear();
+        release_heap();
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            clear();
+            release_heap();
+            take(other);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> init)
+    {
+        assign(init);
+        return *this;
+    }
+
+    void assign(size_type count, const T& value)
+    {
+        clear();
+        reserve(count);
+        std::uninitialized_fill_n(data_, count, value);
+        size_ = count;
+    }
+
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+        clear();
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+    }
+
+    // Element access
+
+    reference at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range{"index out of bounds"};
+        }
+        return data_[index];
+    }
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range{"index out of bounds"};
+        }
+        return data_[index];
+    }
+
+    reference operator[](size_type index) noexcept { return data_[index]; }
+    const_reference operator[](size_type index) const noexcept
+    {
+        return data_[index];
+    }
+
+    reference front() noexcept { return data_[0]; }
+    const_reference front() const noexcept { return data_[0]; }
+    reference back() noexcept { return data_[size_ - 1]; }
+    const_reference back() const noexcept { return data_[size_ - 1]; }
+
+    pointer data() noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+
+    // Iterators
+
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator{end()};
+    }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator{begin()};
+    }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Capacity
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept
+    {
+        return static_cast<size_type>(
+                   std::numeric_limits<difference_type>::max()) /
+               sizeof(T);
+    }
+    size_type capacity() const noexcept { return capacity_; }
+
+    // True if the elements are stored inside the small_vector itself.
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity > capacity_) {
+            reallocate(new_capacity);
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if (is_inline() || size_ == capacity_) {
+            return;
+        }
+        if (size_ <= N) {
+            T* heap{data_};
+            const size_type heap_capacity{capacity_};
+            relocate(heap, size_, inline_data());
+            std::allocator<T>{}.deallocate(heap, heap_capacity);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+        else {
+            reallocate(size_);
+        }
+    }
+
+    // Modifiers
+
+    void clear() noexcept
+    {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    iterator insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type count, const T& value)
+    {
+        // `value` might be an element, which growing would move.
+        const T copy{value};
+        const auto offset{pos - cbegin()};
+        const size_type old_size{size_};
+        reserve(size_ + count);
+        std::uninitialized_fill_n(end(), count, copy);
+        size_ += count;
+        std::rotate(begin() + offset, begin() + old_size, end());
+        return begin() + offset;
+    }
+
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const auto offset{pos - cbegin()};
+        const size_type old_size{size_};
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + offset, begin() + old_size, end());
+        return begin() + offset;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    // Inserting anywhere but the end appends and then rotates the new element
+    // into place.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const auto offset{pos - cbegin()};
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const iterator out{begin() + (first - cbegin())};
+        const auto count{static_cast<size_type>(last - first)};
+        if (count > 0) {
+            std::move(out + count, end(), out);
+            std::destroy_n(end() - count, count);
+            size_ -= count;
+        }
+        return out;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (size_ < capacity_) {
+            std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        }
+        else {
+            // Construct the new element before moving the old ones, in case
+            // the arguments refer to them.  (capacity_ is never less than N;
+            // the max just lets the compiler see that the new block isn't
+            // empty.)
+            const size_type new_capacity{std::max(capacity_ * 2, N * 2)};
+            T* p{std::allocator<T>{}.allocate(new_capacity)};
+            try {
+                std::construct_at(p + size_, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                std::allocator<T>{}.deallocate(p, new_capacity);
+                throw;
+            }
+            relocate(data_, size_, p);
+            release_heap();
+            data_ = p;
+            capacity_ = new_capacity;
+        }
+        return data_[size_++];
+    }
+
+    void pop_back() noexcept
+    {
+        size_--;
+        std::destroy_at(data_ + size_);
+    }
+
+    void resize(size_type count)
+    {
+        if (count > size_) {
+            reserve(count);
+            std::uninitialized_value_construct_n(end(), count - size_);
+            size_ = count;
+        }
+        else {
+            erase(begin() + count, end());
+        }
+    }
+
+    void resize(size_type count, const value_type& value)
+    {
+        if (count > size_) {
+            insert(end(), count - size_, value);
+        }
+        else {
+            erase(begin() + count, end());
+        }
+    }
+
+    void swap(small_vector& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        small_vector tmp{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Non-member functions
+
+    friend bool operator==(const small_vector& lhs,
+                           const small_vector& rhs) noexcept
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const small_vector& lhs,
+                            const small_vector& rhs) noexcept
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend void swap(small_vector& lhs, small_vector& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        lhs.swap(rhs);
+    }
+
+   private:
+    T* data_{inline_data()};
+    size_type size_{0};
+    size_type capacity_{N};
+    alignas(T) std::array<std::byte, N * sizeof(T)> storage_;
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(storage_.data()); }
+    const T* inline_data() const noexcept
+    {
+        return reinterpret_cast<const T*>(storage_.data());
+    }
+
+    // Move `count` elements from `from` to uninitialized storage at `to`,
+    // ending the lifetimes of the originals.
+    static void relocate(T* from, size_type count, T* to) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if constexpr (trivially_relocatable) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+            }
+        }
+        else {
+            std::uninitialized_move_n(from, count, to);
+            std::destroy_n(from, count);
+        }
+    }
+
+    void reallocate(size_type new_capacity)
+    {
+        T* p{std::allocator<T>{}.allocate(new_capacity)};
+        relocate(data_, size_, p);
+        release_heap();
+        data_ = p;
+        capacity_ = new_capacity;
+    }
+
+    void release_heap() noexcept
+    {
+        if (!is_inline()) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    // Take over the contents of `other`, leaving it empty.  This vector must
+    // already be empty and inline.
+    void take(small_vector& other)
+    {
+        if (other.is_inline()) {
+            relocate(other.data_, other.size_, inline_data());
+        }
+        else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+};
+
+template <typename T, std::size_t N, typename U>
+typename small_vector<T, N>::size_type erase(small_vector<T, N>& c,
+                                             const U& value)
+{
+    const auto iter{std::remove(c.begin(), c.end(), value)};
+    const auto count{static_cast<std::size_t>(c.end() - iter)};
+    c.erase(iter, c.end());
+    return count;
+}
+
+template <typename T, std::size_t N, typename Pred>
+typename small_vector<T, N>::size_type erase_if(small_vector<T, N>& c,
+                                                Pred pred)
+{
+    const auto iter{std::remove_if(c.begin(), c.end(), pred)};
+    const auto count{static_cast<std::size_t>(c.end() - iter)};
+    c.erase(iter, c.end());
+    return count;
+}
+
+}  // namespace aoc
+
+#endif  // SMALL_VECTOR_HPP
@@ -55,6 +55,7 @@ const std::map<date, std::vector<solution>>& solutions()
          {
              {aoc::year2021::day05map, "map"},
              {aoc::year2021::day05hash, "hash"},
+             {aoc::year2021::day05flat, "flat"},
              {aoc::year2021::day05sortvec, "sortvec"},
              {aoc::year2021::day05grid, "grid"},
          }},
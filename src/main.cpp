@@ -6,6 +6,7 @@
 //
 
 #include <aoc.hpp>
+#include <aoc_arena.hpp>
 #include <aoc_range.hpp>
 #include <aoc_solutions.hpp>
 #include <runner_options.hpp>
@@ -37,6 +38,9 @@ void run_solution(aoc::date date,
 
     const auto start{Clock::now()};
 
+    // Each iteration starts with an empty arena, so solutions which use it
+    // free everything at once here rather than node by node.
+    solution_arena().reset();
     const auto& result{sol.func(input)};
     int i{1};
     for (; i < options.repeat; i++) {
@@ -48,6 +52,7 @@ void run_solution(aoc::date date,
         }
 
         // Solve problem
+        solution_arena().reset();
         const auto& new_result{sol.func(input)};
         if (new_result != result) {
             fmt::print(
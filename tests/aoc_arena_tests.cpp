@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_arena.hpp>
+#include <aoc_graph.hpp>
+#include <aoc_grid.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory_resource>
+#include <set>
+#include <vector>
+
+using namespace aoc;
+
+TEST_CASE("arena allocates from its block", "[arena]")
+{
+    arena a{4096};
+    std::pmr::vector<int> v{a.resource()};
+    v.reserve(16);
+    const int* first{v.data()};
+    v.clear();
+    v.shrink_to_fit();
+
+    // Memory freed by a container isn't reused until the arena is reset.
+    std::pmr::vector<int> w{a.resource()};
+    w.reserve(16);
+    CHECK(w.data() != first);
+
+    a.reset();
+    std::pmr::vector<int> x{a.allocator<int>()};
+    x.reserve(16);
+    CHECK(x.data() == first);
+    CHECK(a.capacity() == 4096);
+}
+
+TEST_CASE("arena grows to cover overflow", "[arena]")
+{
+    arena a{256};
+    {
+        std::pmr::set<int> s{a.resource()};
+        for (int i{0}; i < 1000; i++) {
+            s.insert(i);
+        }
+        CHECK(s.size() == 1000);
+    }
+    a.reset();
+    const std::size_t grown{a.capacity()};
+    CHECK(grown > 256);
+
+    // The same work now fits, so the block stays the same size.
+    {
+        std::pmr::set<int> s{a.resource()};
+        for (int i{0}; i < 1000; i++) {
+            s.insert(i);
+        }
+    }
+    a.reset();
+    CHECK(a.capacity() == grown);
+}
+
+TEST_CASE("dynamic_grid from an arena", "[arena]")
+{
+    arena a{4096};
+    dynamic_grid<char> grid{3, 2, a.resource()};
+    CHECK(grid.data_.resource() == a.resource());
+    grid[{1, 1}] = 'x';
+
+    // Copies don't follow the original into the arena, which is reset
+    // between runs, unless asked to.
+    const dynamic_grid<char> copy{grid};
+    CHECK(copy.data_.resource() == std::pmr::get_default_resource());
+    CHECK(copy == grid);
+    const dynamic_grid<char> arena_copy{grid, a.resource()};
+    CHECK(arena_copy.data_.resource() == a.resource());
+    CHECK(arena_copy == grid);
+
+    const dynamic_grid<char> heap_grid{3, 2};
+    CHECK(heap_grid.data_.resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("BFS bookkeeping in an arena", "[arena]")
+{
+    arena a;
+    auto adj_func{[](int v) { return std::vector<int>{v + 1, v + 2}; }};
+    const auto path{bfs_path(adj_func, 0, 9, a.resource())};
+    CHECK(path.size() == 6);
+    CHECK(path.front() == 0);
+    CHECK(path.back() == 9);
+}
@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_box_set.hpp>
+#include <aoc_vec.hpp>
+
+#include <catch2/catch_all.hpp>
+
+using namespace aoc;
+
+TEST_CASE("box_set 2D", "[box_set]")
+{
+    box_set<int, 2> set;
+    CHECK(set.volume() == 0);
+
+    set.insert(box_from_rect(rect<int>{{0, 0}, {4, 4}}));
+    CHECK(set.volume() == 16);
+
+    // Overlapping the first square in a 2x2 corner.
+    set.insert(box_from_rect(rect<int>{{2, 2}, {4, 4}}));
+    CHECK(set.volume() == 28);
+
+    // Inserting the same region again changes nothing.
+    set.insert(box_from_rect(rect<int>{{2, 2}, {4, 4}}));
+    CHECK(set.volume() == 28);
+
+    // A hole in the middle of the first square.
+    set.subtract(box_from_rect(rect<int>{{1, 1}, {2, 2}}));
+    CHECK(set.volume() == 24);
+    CHECK(set.volume_within({{0, 0}, {3, 3}}) == 5);
+
+    // Subtracting everything leaves nothing to represent.
+    set.subtract({{-10, -10}, {10, 10}});
+    CHECK(set.volume() == 0);
+    CHECK(set.box_count() == 0);
+}
+
+TEST_CASE("box_set 3D", "[box_set]")
+{
+    // The small example from 2021 day 22.
+    box_set<int, 3> set;
+    set.insert(box_from_corners(vec3<int>{10, 10, 10}, vec3<int>{12, 12, 12}));
+    CHECK(set.volume() == 27);
+    set.insert(box_from_corners(vec3<int>{11, 11, 11}, vec3<int>{13, 13, 13}));
+    CHECK(set.volume() == 46);
+    set.subtract(box_from_corners(vec3<int>{9, 9, 9}, vec3<int>{11, 11, 11}));
+    CHECK(set.volume() == 38);
+    set.insert(box_from_corners(vec3<int>{10, 10, 10}, vec3<int>{10, 10, 10}));
+    CHECK(set.volume() == 39);
+    CHECK(set.volume_within({{0, 0, 0}, {11, 11, 11}}) == 1);
+}
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_cycle.hpp>
+#include <aoc_hash.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+using namespace aoc;
+
+namespace {
+// x -> x^2 + 1 mod 255 starting from 3 enters a cycle of length 6 after two
+// steps: 3, 10, 101, 2, 5, 26, 167, 95, 101, ...
+void square_plus_one(int& x)
+{
+    x = (x * x + 1) % 255;
+}
+}  // namespace
+
+TEST_CASE("MurmurHash3 reference values", "[hash]")
+{
+    const std::string_view hello{"hello"};
+    CHECK(hash_span(std::span{hello}) ==
+          fingerprint{0xcbd8a7b341bd9b02ULL, 0x5b1e906a48ae1d19ULL});
+    const std::string_view fox{"The quick brown fox jumps over the lazy dog"};
+    CHECK(hash_span(std::span{fox}) ==
+          fingerprint{0xe34bbc7bbc071b6cULL, 0x7a433ca9c49a9347ULL});
+    CHECK(hash_span(std::span{fox}, 1) != hash_span(std::span{fox}));
+}
+
+TEST_CASE("find_cycle_brent", "[cycle]")
+{
+    const cycle c{find_cycle_brent(3, square_plus_one)};
+    CHECK(c == cycle{2, 6});
+    CHECK(c.equivalent_step(1) == 1);
+    CHECK(c.equivalent_step(8) == 2);
+    CHECK(c.equivalent_step(1000) == 2 + (1000 - 2) % 6);
+
+    // A state which is its own successor is a cycle of length one.
+    CHECK(find_cycle_brent(0, [](int&) {}) == cycle{0, 1});
+}
+
+TEST_CASE("cycle_detector", "[cycle]")
+{
+    cycle_detector<int> detector;
+    int x{3};
+    std::optional<cycle> c;
+    while (!(c = detector.record(x))) {
+        square_plus_one(x);
+    }
+    CHECK(*c == cycle{2, 6});
+    CHECK(detector.steps() == 8);
+}
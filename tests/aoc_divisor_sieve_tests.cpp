@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_divisor_sieve.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+std::uint64_t naive_sigma(std::uint64_t n, std::uint64_t max_multiple)
+{
+    std::uint64_t sum{0};
+    for (std::uint64_t d{1}; d <= n; d++) {
+        if (n % d == 0 && n / d <= max_multiple) {
+            sum += d;
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST_CASE("divisor_sigma_sieve fill", "[divisor_sieve]")
+{
+    const std::array<std::uint64_t, 3> caps{divisor_sigma_sieve::unlimited, 50,
+                                            3};
+    for (const auto max_multiple : caps) {
+        const divisor_sigma_sieve sieve{max_multiple};
+        // Segments which do and don't start at a square.
+        for (const std::uint64_t first : {0U, 1U, 37U, 64U, 1000U}) {
+            std::vector<std::uint64_t> sums(300);
+            sieve.fill(first, sums);
+            for (std::size_t i{0}; i < sums.size(); i++) {
+                CHECK(sums[i] == naive_sigma(first + i, max_multiple));
+            }
+        }
+    }
+}
+
+TEST_CASE("divisor_sigma_sieve find_first", "[divisor_sieve]")
+{
+    // The examples from 2015 day 20: house 8 gets 150 presents, 10 times the
+    // sum of its divisors, and is the first to get at least 130.
+    CHECK(divisor_sigma_sieve{}.find_first(13) == 8);
+    CHECK(divisor_sigma_sieve{}.find_first(15) == 8);
+    CHECK(divisor_sigma_sieve{}.find_first(16) == 10);
+
+    // Across several segments and threads.
+    for (const std::size_t threads : {1U, 3U}) {
+        CHECK(divisor_sigma_sieve{}.find_first(100000, threads) == 27720);
+        CHECK(divisor_sigma_sieve{2}.find_first(100000, threads) == 66668);
+    }
+}
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_flat_hash.hpp>
+#include <aoc_vec.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace aoc;
+
+TEST_CASE("flat_hash_map insert and find", "[flat_hash]")
+{
+    flat_hash_map<int, std::string> m;
+    CHECK(m.empty());
+    CHECK(m.find(1) == m.end());
+
+    const auto [iter, inserted]{m.try_emplace(1, "one")};
+    CHECK(inserted);
+    CHECK(iter->second == "one");
+    CHECK_FALSE(m.try_emplace(1, "uno").second);
+    CHECK(m.at(1) == "one");
+
+    m[2] = "two";
+    m.insert({3, "three"});
+    m.emplace(4, "four");
+    m.insert_or_assign(4, "FOUR");
+    CHECK(m.size() == 4);
+    CHECK(m.contains(2));
+    CHECK(m.count(3) == 1);
+    CHECK(m.at(4) == "FOUR");
+    CHECK_THROWS_AS(m.at(5), std::out_of_range);
+}
+
+TEST_CASE("flat_hash_map matches std::map", "[flat_hash]")
+{
+    // Enough keys for several rehashes, with erasures mixed in so that some
+    // slots become tombstones.
+    flat_hash_map<int, int> m;
+    std::map<int, int> expected;
+    for (int i{0}; i < 5000; i++) {
+        const int key{(i * 7919) % 3001};
+        if (i % 3 == 2) {
+            CHECK(m.erase(key) == expected.erase(key));
+        }
+        else {
+            m[key] += i;
+            expected[key] += i;
+        }
+    }
+    CHECK(m.size() == expected.size());
+    for (const auto& [key, value] : expected) {
+        CHECK(m.at(key) == value);
+    }
+    std::vector<std::pair<int, int>> contents{m.begin(), m.end()};
+    std::ranges::sort(contents);
+    CHECK(contents ==
+          std::vector<std::pair<int, int>>{expected.begin(), expected.end()});
+}
+
+TEST_CASE("flat_hash_map erase while iterating", "[flat_hash]")
+{
+    flat_hash_map<int, int> m;
+    for (int i{0}; i < 100; i++) {
+        m[i] = i;
+    }
+    for (auto iter{m.begin()}; iter != m.end();) {
+        iter = iter->first % 2 == 0 ? m.erase(iter) : std::next(iter);
+    }
+    CHECK(m.size() == 50);
+    CHECK(std::ranges::all_of(m, [](const auto& kv) { return kv.first % 2; }));
+}
+
+TEST_CASE("flat_hash_map copy, move and compare", "[flat_hash]")
+{
+    flat_hash_map<std::string, std::unique_ptr<int>> owners;
+    owners.try_emplace("a", std::make_unique<int>(1));
+    auto moved{std::move(owners)};
+    CHECK(owners.empty());
+    CHECK(*moved.at("a") == 1);
+
+    const flat_hash_map<std::string, int> m{{"a", 1}, {"b", 2}};
+    flat_hash_map<std::string, int> copy{m};
+    CHECK(copy == m);
+    copy["c"] = 3;
+    CHECK(copy != m);
+    copy = m;
+    CHECK(copy == m);
+
+    copy.clear();
+    CHECK(copy.empty());
+    CHECK(copy.find("a") == copy.end());
+}
+
+TEST_CASE("flat_hash_set", "[flat_hash]")
+{
+    flat_hash_set<vec2<int>> s;
+    for (int y{-10}; y < 10; y++) {
+        for (int x{-10}; x < 10; x++) {
+            CHECK(s.insert({x, y}).second);
+        }
+    }
+    CHECK_FALSE(s.insert({0, 0}).second);
+    CHECK(s.size() == 400);
+    CHECK(s.contains({-10, 9}));
+    CHECK_FALSE(s.contains({10, 0}));
+
+    s.reserve(10000);
+    CHECK(s.capacity() >= 10000);
+    CHECK(s.size() == 400);
+    CHECK(s.contains({3, -4}));
+}
+
+TEST_CASE("vec2 hash mixes neighbouring points", "[flat_hash]")
+{
+    // The low 7 bits of the hash go in the control byte, so they have to
+    // differ between adjacent points as much as any other bits.
+    const std::hash<vec2<int>> h;
+    int differing_bits{0};
+    for (int y{0}; y < 64; y++) {
+        for (int x{0}; x < 64; x++) {
+            differing_bits += std::popcount((h({x, y}) ^ h({x + 1, y})) & 0x7f);
+        }
+    }
+    // About half of the 7 bits for each pair.
+    CHECK(differing_bits > 64 * 64 * 3);
+    CHECK(differing_bits < 64 * 64 * 4);
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_generator.hpp>
+#include <aoc_range.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+generator<int> count_to(int n)
+{
+    for (int i{0}; i < n; i++) {
+        co_yield i;
+    }
+}
+
+// Counts copies made of it, to check that yielding doesn't copy.
+struct copy_counter {
+    int* copies;
+
+    explicit copy_counter(int* c) : copies{c} {}
+    copy_counter(const copy_counter& other) : copies{other.copies}
+    {
+        ++*copies;
+    }
+    copy_counter& operator=(const copy_counter& other)
+    {
+        copies = other.copies;
+        ++*copies;
+        return *this;
+    }
+};
+
+generator<copy_counter> yield_counter(int* copies, int n)
+{
+    copy_counter counter{copies};
+    for (int i{0}; i < n; i++) {
+        co_yield counter;
+    }
+}
+
+generator<std::vector<int>&> grow(int n)
+{
+    std::vector<int> v;
+    for (int i{0}; i < n; i++) {
+        v.push_back(i);
+        co_yield v;
+    }
+}
+
+generator<int> throw_after(int n)
+{
+    for (int i{0}; i < n; i++) {
+        co_yield i;
+    }
+    throw std::runtime_error{"done"};
+}
+
+}  // namespace
+
+TEST_CASE("generator yields in order", "[generator]")
+{
+    std::vector<int> out;
+    for (const int i : count_to(5)) {
+        out.push_back(i);
+    }
+    CHECK(out == std::vector<int>{0, 1, 2, 3, 4});
+
+    auto empty{count_to(0)};
+    CHECK(empty.begin() == empty.end());
+}
+
+TEST_CASE("generator yields without copying", "[generator]")
+{
+    int copies{0};
+    int yields{0};
+    for (const copy_counter& c : yield_counter(&copies, 10)) {
+        CHECK(c.copies == &copies);
+        yields++;
+    }
+    CHECK(yields == 10);
+    CHECK(copies == 0);
+}
+
+TEST_CASE("generator of references", "[generator]")
+{
+    std::size_t expected_size{1};
+    for (std::vector<int>& v : grow(3)) {
+        CHECK(v.size() == expected_size++);
+        // The caller may modify what it was given.
+        v.back() *= 10;
+    }
+    CHECK(expected_size == 4);
+}
+
+TEST_CASE("generator reuses frames", "[generator]")
+{
+    const void* first_frame{nullptr};
+    {
+        auto g{count_to(3)};
+        auto iter{g.begin()};
+        first_frame = &*iter;
+    }
+    auto g{count_to(3)};
+    auto iter{g.begin()};
+    // The yielded value lives in the frame, so the same address means the
+    // same frame.
+    CHECK(&*iter == first_frame);
+}
+
+TEST_CASE("generator composes with views", "[generator]")
+{
+    auto g{count_to(5)};
+    const auto squares{g | rv::transform([](int i) { return i * i; }) |
+                       r::to<std::vector>};
+    CHECK(squares == std::vector<int>{0, 1, 4, 9, 16});
+}
+
+TEST_CASE("generator propagates exceptions", "[generator]")
+{
+    int sum{0};
+    const auto consume{[&] {
+        for (const int i : throw_after(3)) {
+            sum += i;
+        }
+    }};
+    CHECK_THROWS_AS(consume(), std::runtime_error);
+    CHECK(sum == 3);
+}
@@ -11,6 +11,7 @@
 #include <catch2/catch_all.hpp>
 
 #include <string>
+#include <string_view>
 
 using namespace aoc;
 
@@ -189,3 +190,45 @@ TEST_CASE("subgrid", "[grid]")
     CHECK(grid3[{2, 3}] == true);
     CHECK(grid3[{3, 2}] == true);
 }
+
+TEST_CASE("row reductions", "[grid]")
+{
+    // Wider than one SIMD block so that both the vector and tail paths run.
+    const std::string_view rows{
+        "......................................#.."
+        "........................................."
+        "#.##..##..#.##..##..#.##..##..#.##..##..."
+        "#.##..##..#.##..##..#.##..##..#.##..##..#"};
+    dynamic_grid<char> grid{41, 4};
+    r::copy(rows, grid.data().data());
+
+    CHECK(row_count(grid, 0, '#') == 1);
+    CHECK(row_count(grid, 2, '#') == 20);
+    CHECK(row_all_of(grid, 1, '.'));
+    CHECK_FALSE(row_all_of(grid, 0, '.'));
+    CHECK(row_any_of(grid, 0, '#'));
+    CHECK_FALSE(row_any_of(grid, 1, '#'));
+    CHECK(row_difference(grid, 2, 3) == 1);
+    CHECK(row_difference(grid, 1, 2) == 20);
+    CHECK(rows_equal(grid, 2, 2));
+    CHECK_FALSE(rows_equal(grid, 2, 3));
+    CHECK(grid_count(grid, '#') == 42);
+}
+
+TEST_CASE("transposed", "[grid]")
+{
+    std::string s{"abcdefghijkl"};
+    // abcd
+    // efgh
+    // ijkl
+    dynamic_grid<char> grid{4, 3};
+    r::copy(s, grid.data().data());
+    const auto t{transposed(grid)};
+    CHECK(t.width() == 3);
+    CHECK(t.height() == 4);
+    CHECK(str(t.data()) == "aeibfjcgkdhl");
+    CHECK(row_count(t, 1, 'f') == 1);
+    for (int x{0}; x < grid.width(); x++) {
+        CHECK(str(t.row(x)) == str(grid.col(x)));
+    }
+}
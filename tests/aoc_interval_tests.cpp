@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_interval.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <vector>
+
+using namespace aoc;
+
+TEST_CASE("interval_set assign", "[interval]")
+{
+    interval_set<int> set;
+    const std::vector<interval<int>> intervals{
+        {10, 12}, {0, 3}, {3, 5}, {11, 15}, {20, 20}, {7, 8}};
+    set.assign(intervals);
+
+    const std::vector<interval<int>> expected{{0, 5}, {7, 8}, {10, 15}};
+    CHECK(std::vector(set.begin(), set.end()) == expected);
+    CHECK(set.length() == 11);
+    CHECK(set.contains(4));
+    CHECK_FALSE(set.contains(5));
+    CHECK(set.find(12)->lo == 10);
+    CHECK(set.find(9) == set.end());
+}
+
+TEST_CASE("interval_set insert and erase", "[interval]")
+{
+    interval_set<int> set{{0, 5}, {7, 8}, {10, 15}};
+
+    set.insert({5, 7});
+    CHECK(set == interval_set<int>{{0, 8}, {10, 15}});
+    set.insert({-5, -3});
+    CHECK(set == interval_set<int>{{-5, -3}, {0, 8}, {10, 15}});
+    set.insert({-4, 20});
+    CHECK(set == interval_set<int>{{-5, 20}});
+
+    set.erase({0, 5});
+    CHECK(set == interval_set<int>{{-5, 0}, {5, 20}});
+    set.erase({-10, -4});
+    CHECK(set == interval_set<int>{{-4, 0}, {5, 20}});
+    set.erase({-1, 6});
+    CHECK(set == interval_set<int>{{-4, -1}, {6, 20}});
+    set.erase({10, 12});
+    CHECK(set == interval_set<int>{{-4, -1}, {6, 10}, {12, 20}});
+}
+
+TEST_CASE("interval_set complement and intersection", "[interval]")
+{
+    const interval_set<int> a{{0, 5}, {7, 8}, {10, 15}};
+    const interval_set<int> b{{3, 11}, {14, 20}};
+
+    CHECK(complement(a, {-2, 12}) ==
+          interval_set<int>{{-2, 0}, {5, 7}, {8, 10}});
+    CHECK(complement(a, {1, 4}).empty());
+    CHECK(intersection(a, b) ==
+          interval_set<int>{{3, 5}, {7, 8}, {10, 11}, {14, 15}});
+}
+
+TEST_CASE("interval_map", "[interval]")
+{
+    interval_map<int, char> map{'.'};
+    map.assign({0, 10}, 'a');
+    map.assign({5, 15}, 'b');
+    map.assign({3, 6}, '.');
+    CHECK(map.at(-100) == '.');
+    CHECK(map.at(0) == 'a');
+    CHECK(map.at(3) == '.');
+    CHECK(map.at(6) == 'b');
+    CHECK(map.at(15) == '.');
+    CHECK(map.breakpoints().size() == 5);
+
+    // Equal neighbours are merged.
+    map.assign({3, 6}, 'a');
+    map.assign({6, 15}, 'a');
+    CHECK(map.breakpoints().size() == 3);
+
+    std::vector<std::pair<interval<int>, char>> pieces;
+    map.for_each({-2, 20}, [&](interval<int> piece, char value) {
+        pieces.emplace_back(piece, value);
+    });
+    const std::vector<std::pair<interval<int>, char>> expected{
+        {{-2, 0}, '.'}, {{0, 15}, 'a'}, {{15, 20}, '.'}};
+    CHECK(pieces == expected);
+}
+
+TEST_CASE("compose_offsets", "[interval]")
+{
+    // The seed-to-soil and soil-to-fertilizer maps from 2023 day 5.
+    interval_map<long, long> seed_to_soil;
+    seed_to_soil.assign({98, 100}, 50 - 98);
+    seed_to_soil.assign({50, 98}, 52 - 50);
+    interval_map<long, long> soil_to_fertilizer;
+    soil_to_fertilizer.assign({15, 52}, 0 - 15);
+    soil_to_fertilizer.assign({52, 54}, 37 - 52);
+    soil_to_fertilizer.assign({0, 15}, 39 - 0);
+
+    const auto composed{compose_offsets(seed_to_soil, soil_to_fertilizer)};
+    for (long seed{0}; seed < 120; seed++) {
+        const long soil{seed + seed_to_soil.at(seed)};
+        const long fertilizer{soil + soil_to_fertilizer.at(soil)};
+        CHECK(seed + composed.at(seed) == fertilizer);
+    }
+    CHECK(composed.at(79) == 81 - 79);
+    CHECK(composed.at(14) == 53 - 14);
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_json.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace aoc;
+
+namespace {
+
+// Writes every token back out, one per line, tagged with its kind.
+struct recorder {
+    std::string out;
+
+    void begin_object() { out += "{\n"; }
+    void end_object() { out += "}\n"; }
+    void begin_array() { out += "[\n"; }
+    void end_array() { out += "]\n"; }
+    void key(std::string_view raw) { out += "k " + std::string{raw} + "\n"; }
+    void string(std::string_view raw)
+    {
+        out += "s " + std::string{raw} + "\n";
+    }
+    void number(std::string_view text)
+    {
+        out += "n " + std::string{text} + "\n";
+    }
+    void boolean(bool value) { out += value ? "true\n" : "false\n"; }
+    void null() { out += "null\n"; }
+};
+
+std::string record(std::string_view text)
+{
+    recorder r;
+    json::scan(text, r);
+    return r.out;
+}
+
+// Only counts numbers, to check the other callbacks are optional.
+struct number_counter {
+    int count{0};
+    void number(std::string_view) { count++; }
+};
+
+}  // namespace
+
+TEST_CASE("json::scan reports tokens in order", "[json]")
+{
+    CHECK(record(R"( {"a": [1, -2.5e+3, "x\"y"], "b": {}, "c": [],)"
+                 R"( "d": true, "e": false, "f": null} )") ==
+          "{\nk a\n[\nn 1\nn -2.5e+3\ns x\\\"y\n]\nk b\n{\n}\n"
+          "k c\n[\n]\nk d\ntrue\nk e\nfalse\nk f\nnull\n}\n");
+    CHECK(record("0") == "n 0\n");
+    CHECK(record(R"("a\\")") == "s a\\\\\n");
+    CHECK(record("[[[]]]\n") == "[\n[\n[\n]\n]\n]\n");
+
+    number_counter counter;
+    json::scan(R"({"a": [1, 2, {"b": "3"}], "c": 4})", counter);
+    CHECK(counter.count == 3);
+}
+
+TEST_CASE("json::scan rejects malformed documents", "[json]")
+{
+    for (const std::string_view bad :
+         {"", " ", "{", "[1,]", "[1 2]", R"({"a" 1})", R"({"a": 1,})",
+          R"({1: 2})", "[1}", "{]", "01", "-", "1.", "1e", "tru", R"("abc)",
+          R"("abc\")", "[] []", "nul"}) {
+        number_counter counter;
+        CHECK_THROWS_AS(json::scan(bad, counter), input_error);
+    }
+
+    number_counter counter;
+    const std::string deep(json::max_depth, '[');
+    const std::string closed{deep + std::string(json::max_depth, ']')};
+    CHECK_NOTHROW(json::scan(closed, counter));
+    CHECK_THROWS_AS(json::scan(deep + "[", counter), input_error);
+}
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_md5.hpp>
+
+extern "C" {
+#include <md5.h>
+}
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+md5_digest reference_md5(std::string_view message)
+{
+    MD5_CTX ctx;
+    MD5_Init(&ctx);
+    MD5_Update(&ctx, message.data(),
+               static_cast<unsigned long>(message.size()));
+    md5_digest digest;
+    MD5_Final(digest.data(), &ctx);
+    return digest;
+}
+
+}  // namespace
+
+TEST_CASE("md5 RFC 1321 test suite", "[md5]")
+{
+    CHECK(md5_hex(md5("")) == "d41d8cd98f00b204e9800998ecf8427e");
+    CHECK(md5_hex(md5("abc")) == "900150983cd24fb0d6963f7d28e17f72");
+    CHECK(md5_hex(md5("message digest")) == "f96b697d7cb7938d525a2f31aaf161d0");
+    CHECK(md5_hex(md5("abcdefghijklmnopqrstuvwxyz")) ==
+          "c3fcd3d76192e4007dfb496cca67e13b");
+    CHECK(md5_hex(md5("12345678901234567890123456789012345678901234567890123456"
+                      "789012345678901234567890")) ==
+          "57edf4a22be3c955ac49da2e2107b67a");
+    CHECK(md5_hex(md5_prefix{"abcdef"}("609043")) ==
+          "000001dbbfa3a5c83a2d506429c7b00e");
+}
+
+TEST_CASE("md5_prefix matches md5 across block boundaries", "[md5]")
+{
+    // Prefix and suffix lengths either side of 55, 56 and 64 bytes, so that
+    // messages take the single block, two block and multi-block paths.
+    for (const std::size_t prefix_size : {0U, 3U, 55U, 56U, 63U, 65U, 130U}) {
+        const std::string prefix(prefix_size, 'k');
+        const md5_prefix key{prefix};
+        std::vector<std::string> suffixes;
+        for (std::size_t n{0}; n < 150; n++) {
+            suffixes.emplace_back(n, static_cast<char>('0' + n % 10));
+        }
+        const std::vector<std::string_view> views{suffixes.begin(),
+                                                  suffixes.end()};
+        std::vector<md5_digest> digests(views.size());
+        key.hash_many(views, digests);
+        for (std::size_t n{0}; n < views.size(); n++) {
+            const auto expected{reference_md5(prefix + suffixes[n])};
+            CHECK(key(views[n]) == expected);
+            CHECK(digests[n] == expected);
+        }
+    }
+}
+
+TEST_CASE("md5_prefix hash_many with a partial batch", "[md5]")
+{
+    const md5_prefix key{"abcdef"};
+    for (std::size_t count{0}; count <= 2 * md5_lanes() + 1; count++) {
+        std::vector<std::string> suffixes;
+        for (std::size_t n{0}; n < count; n++) {
+            suffixes.push_back(std::to_string(609043 + n));
+        }
+        const std::vector<std::string_view> views{suffixes.begin(),
+                                                  suffixes.end()};
+        std::vector<md5_digest> digests(count);
+        key.hash_many(views, digests);
+        for (std::size_t n{0}; n < count; n++) {
+            CHECK(digests[n] == reference_md5("abcdef" + suffixes[n]));
+        }
+    }
+}
+
+TEST_CASE("decimal_counter", "[md5]")
+{
+    decimal_counter n{0};
+    CHECK(n.view() == "0");
+    CHECK((++n).view() == "1");
+    decimal_counter m{998};
+    ++m;
+    CHECK(m.view() == "999");
+    ++m;
+    CHECK(m.view() == "1000");
+    std::array<char, 20> buffer;
+    CHECK(m.copy_to(buffer) == "1000");
+}
+
+TEST_CASE("md5_find_first", "[md5]")
+{
+    const auto five_zeroes{[](const md5_digest& d) {
+        return d[0] == 0 && d[1] == 0 && (d[2] & 0xf0) == 0;
+    }};
+    const auto first_byte_zero{
+        [](const md5_digest& d) { return d[0] == 0; }};
+    const auto [a, b]{
+        md5_find_first(md5_prefix{"abcdef"}, 0, five_zeroes, first_byte_zero)};
+    CHECK(a == 609043);
+    std::int64_t expected{0};
+    while (md5(fmt::format("abcdef{}", expected))[0] != 0) {
+        expected++;
+    }
+    CHECK(b == expected);
+}
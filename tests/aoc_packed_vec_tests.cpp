@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_packed_vec.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+template <typename Packed>
+void check_round_trip_2d()
+{
+    for (const int x : {INT_MIN, -1000, -1, 0, 1, 77, INT_MAX}) {
+        for (const int y : {INT_MIN, -3, 0, 5, INT_MAX}) {
+            const Packed p{x, y};
+            CHECK(p.x() == x);
+            CHECK(p.y() == y);
+            CHECK(static_cast<vec2<int>>(p) == vec2<int>{x, y});
+        }
+    }
+}
+
+template <typename Packed>
+void check_round_trip_3d()
+{
+    constexpr int lo{-(1 << 20)};
+    constexpr int hi{(1 << 20) - 1};
+    for (const int x : {lo, -9, 0, 12, hi}) {
+        for (const int y : {lo, -1, 0, 1, hi}) {
+            for (const int z : {lo, -300, 0, 4, hi}) {
+                const Packed p{x, y, z};
+                CHECK(static_cast<vec3<int>>(p) == vec3<int>{x, y, z});
+            }
+        }
+    }
+}
+
+template <typename Packed>
+void check_offsets_2d()
+{
+    using offset = typename Packed::offset;
+    for (const int x : {-5, -1, 0, 1, 5}) {
+        for (const int y : {-5, -1, 0, 1, 5}) {
+            const Packed p{x, y};
+            for (const int dx : {-3, -1, 0, 2}) {
+                for (const int dy : {-2, 0, 1, 3}) {
+                    const Packed q{p + offset{dx, dy}};
+                    CHECK(q == Packed{x + dx, y + dy});
+                    CHECK(q - p == offset{dx, dy});
+                }
+            }
+        }
+    }
+}
+
+template <typename Packed>
+void check_offsets_3d()
+{
+    using offset = typename Packed::offset;
+    const Packed p{-1, 0, 1};
+    for (const int d : {-4, -1, 0, 1, 4}) {
+        const Packed q{p + offset{d, -d, 2 * d}};
+        CHECK(q == Packed{-1 + d, -d, 1 + 2 * d});
+        CHECK(q - p == offset{d, -d, 2 * d});
+    }
+    const auto neighbors{p.face_neighbors()};
+    CHECK(neighbors[0] == Packed{-2, 0, 1});
+    CHECK(neighbors[5] == Packed{-1, 0, 2});
+}
+
+}  // namespace
+
+TEST_CASE("packed_vec2 round trip", "[packed_vec]")
+{
+    check_round_trip_2d<packed_vec2<>>();
+    check_round_trip_2d<packed_vec2<packing::morton>>();
+}
+
+TEST_CASE("packed_vec3 round trip", "[packed_vec]")
+{
+    check_round_trip_3d<packed_vec3<>>();
+    check_round_trip_3d<packed_vec3<packing::morton>>();
+}
+
+TEST_CASE("packed_vec offsets", "[packed_vec]")
+{
+    check_offsets_2d<packed_vec2<>>();
+    check_offsets_2d<packed_vec2<packing::morton>>();
+    check_offsets_3d<packed_vec3<>>();
+    check_offsets_3d<packed_vec3<packing::morton>>();
+
+    const packed_vec2<> p{3, -3};
+    const auto neighbors{p.orthogonal_neighbors()};
+    CHECK(neighbors[0] == packed_vec2<>{2, -3});
+    CHECK(neighbors[3] == packed_vec2<>{3, -2});
+}
+
+TEST_CASE("packed_vec lexicographic order matches vec", "[packed_vec]")
+{
+    std::vector<vec2<int>> points;
+    for (int x{-3}; x <= 3; x++) {
+        for (int y{-3}; y <= 3; y++) {
+            points.push_back({x * 1000, y});
+        }
+    }
+    std::set<packed_vec2<>> packed;
+    for (const auto p : points) {
+        packed.insert(packed_vec2<>{p});
+    }
+    std::ranges::sort(points);
+    CHECK(std::ranges::equal(packed, points, std::ranges::equal_to{},
+                             [](vec2<int> p) { return p; }));
+
+    CHECK(packed_vec3<>{-1, 5, 5} < packed_vec3<>{0, -5, -5});
+    CHECK(packed_vec3<>{0, -1, 5} < packed_vec3<>{0, 0, -5});
+}
+
+TEST_CASE("packed_vec morton order is Z-order", "[packed_vec]")
+{
+    // Within an aligned 2x2 block, the four points come before the next block.
+    using morton = packed_vec2<packing::morton>;
+    CHECK(morton{0, 0} < morton{0, 1});
+    CHECK(morton{0, 1} < morton{1, 0});
+    CHECK(morton{1, 0} < morton{1, 1});
+    CHECK(morton{1, 1} < morton{0, 2});
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_parallel.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+// First index in `[first, last)` which is a multiple of `m` and at least
+// `min`, or `no_match`.
+std::int64_t first_multiple(std::int64_t first, std::int64_t last,
+                            std::int64_t m, std::int64_t min)
+{
+    for (std::int64_t i{std::max(first, min)}; i < last; i++) {
+        if (i % m == 0) {
+            return i;
+        }
+    }
+    return no_match;
+}
+
+}  // namespace
+
+TEST_CASE("parallel_find_first finds the minimum of each condition",
+          "[parallel]")
+{
+    for (const std::size_t threads : {1U, 2U, 7U}) {
+        const auto found{parallel_find_first<3>(
+            5, 10,
+            [](std::int64_t first, std::int64_t last) {
+                return std::array{first_multiple(first, last, 7, 0),
+                                  first_multiple(first, last, 1000, 0),
+                                  first_multiple(first, last, 13, 5000)};
+            },
+            threads)};
+        CHECK(found == std::array<std::int64_t, 3>{7, 1000, 5005});
+    }
+}
+
+TEST_CASE("parallel_find_first passes on exceptions", "[parallel]")
+{
+    const auto search{[](std::int64_t first, std::int64_t) {
+        if (first >= 100) {
+            throw std::runtime_error("too far");
+        }
+        return std::array{no_match};
+    }};
+    CHECK_THROWS_AS(parallel_find_first<1>(0, 10, search, 3),
+                    std::runtime_error);
+}
+
+TEST_CASE("parallel_for covers every index once", "[parallel]")
+{
+    for (const std::size_t threads : {1U, 3U, 16U}) {
+        for (const std::size_t count : {0U, 1U, 5U, 100U}) {
+            std::vector<int> visits(count);
+            parallel_for(
+                count,
+                [&visits](std::size_t first, std::size_t last) {
+                    for (std::size_t i{first}; i < last; i++) {
+                        visits[i]++;
+                    }
+                },
+                threads);
+            CHECK(std::ranges::all_of(visits, [](int v) { return v == 1; }));
+        }
+    }
+    CHECK_THROWS_AS(parallel_for(
+                        10,
+                        [](std::size_t first, std::size_t) {
+                            if (first > 0) {
+                                throw std::runtime_error("block");
+                            }
+                        },
+                        4),
+                    std::runtime_error);
+}
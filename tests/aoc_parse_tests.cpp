@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc.hpp>
+#include <aoc_parse.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+using namespace aoc;
+
+namespace {
+
+enum class switch_action { on, off };
+
+constexpr auto point{parse::integer<int> + "," + parse::integer<int>};
+constexpr auto switch_grammar{(parse::lit("turn on ", switch_action::on) |
+                               parse::lit("turn off ", switch_action::off)) +
+                              point + " through " + point};
+
+struct switch_record {
+    switch_action action;
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+};
+
+}  // namespace
+
+TEST_CASE("parse_line", "[parse]")
+{
+    CHECK(parse::parse_line(switch_grammar, "turn off 1,-2 through 30,40") ==
+          std::tuple{switch_action::off, 1, -2, 30, 40});
+
+    // Grammars can be evaluated at compile time.
+    static_assert(std::get<2>(parse::parse_line(
+                      switch_grammar, "turn on 0,7 through 1,1")) == 7);
+
+    CHECK_THROWS_AS(parse::parse_line(switch_grammar, "turn on 1,2 through 3"),
+                    input_error);
+    CHECK_THROWS_AS(parse::parse_line(switch_grammar, "toggle 1,2 through 3,4"),
+                    input_error);
+    // The whole line must match.
+    CHECK_THROWS_AS(
+        parse::parse_line(switch_grammar, "turn on 1,2 through 3,4 "),
+        input_error);
+    // Out of range for the field's type.
+    CHECK_THROWS_AS(parse::parse_line("x=" + parse::integer<std::int8_t>,
+                                      "x=200"),
+                    input_error);
+}
+
+TEST_CASE("parse_record", "[parse]")
+{
+    const auto record{parse::parse_record<switch_record>(
+        switch_grammar, "turn on 5,6 through 7,8")};
+    CHECK(record.action == switch_action::on);
+    CHECK(record.x1 == 5);
+    CHECK(record.y2 == 8);
+
+    constexpr auto word_grammar{parse::word + " -> " + parse::word};
+    CHECK(parse::parse_line(word_grammar, "x123 -> h") ==
+          std::tuple<std::string_view, std::string_view>{"x123", "h"});
+}
+
+TEST_CASE("parse_table", "[parse]")
+{
+    const auto table{parse::parse_table(
+        switch_grammar,
+        "turn on 0,0 through 9,9\nturn off 1,2 through 3,4\n")};
+    REQUIRE(table.size() == 2);
+    CHECK(table.column<0>()[1] == switch_action::off);
+    CHECK(table.column<2>()[1] == 2);
+    CHECK(table.column<4>()[0] == 9);
+}
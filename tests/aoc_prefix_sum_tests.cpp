@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_grid.hpp>
+#include <aoc_prefix_sum.hpp>
+#include <aoc_range.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+
+using namespace aoc;
+
+TEST_CASE("prefix_sum_grid", "[prefix_sum]")
+{
+    // 1 2 3 4
+    // 5 6 7 8
+    // 9 0 1 2
+    const std::array values{1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2};
+    dynamic_grid<int> grid{4, 3};
+    r::copy(values, grid.data().data());
+
+    const prefix_sum_grid<long> sums{grid};
+    CHECK(sums.total() == 48);
+    CHECK(sums.sum({{0, 0}, {1, 1}}) == 1);
+    CHECK(sums.sum({{1, 1}, {2, 2}}) == 14);
+    CHECK(sums.sum({{3, 0}, {1, 3}}) == 14);
+    CHECK(sums.sum({{0, 2}, {4, 1}}) == 12);
+    CHECK(sums.sum({{2, 1}, {0, 2}}) == 0);
+}
+
+TEST_CASE("difference_grid", "[prefix_sum]")
+{
+    difference_grid<int> diffs{5, 4};
+    diffs.add({{0, 0}, {5, 4}}, 1);
+    diffs.add({{1, 1}, {3, 2}}, 10);
+    diffs.add({{4, 3}, {1, 1}}, -1);
+    diffs.toggle({{0, 0}, {2, 1}});
+
+    const auto values{diffs.values()};
+    const std::array<int, 20> expected{
+        2, 2,  1,  1,  1,  //
+        1, 11, 11, 11, 1,  //
+        1, 11, 11, 11, 1,  //
+        1, 1,  1,  1,  0};
+    CHECK(r::equal(values.data(), expected));
+
+    const auto sums{diffs.prefix_sums()};
+    CHECK(sums.total() == r::accumulate(expected, 0));
+    CHECK(sums.sum({{1, 1}, {3, 2}}) == 66);
+}
@@ -9,10 +9,25 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <array>
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 using namespace aoc;
 
+namespace {
+
+template <typename T>
+concept splittable = requires(T&& t) { sv_lines(std::forward<T>(t)); };
+
+template <typename T>
+concept number_source = requires(T&& t) { numbers<int>(std::forward<T>(t)); };
+
+}  // namespace
+
 TEST_CASE("convert lines to ints", "[to_int]")
 {
     const std::string_view str{"199\n203\n200\n"};
@@ -27,3 +42,71 @@ TEST_CASE("convert bool ranges to ints", "[bool_range_to_int]")
                       false, true, true, false, true, false, true,  false};
     CHECK(bool_range_to_int(a26986) == 26986);
 }
+
+TEST_CASE("split into lines", "[sv_lines]")
+{
+    using lines_t = std::vector<std::string_view>;
+    CHECK((sv_lines(std::string_view{"ab\ncd\n"}) | r::to<std::vector>()) ==
+          lines_t{"ab", "cd"});
+    CHECK((sv_lines(std::string_view{"ab\n\ncd"}) | r::to<std::vector>()) ==
+          lines_t{"ab", "", "cd"});
+    CHECK(r::empty(sv_lines(std::string_view{""})));
+
+    // Views into a temporary string would dangle.
+    static_assert(splittable<std::string_view>);
+    static_assert(splittable<const std::string&>);
+    static_assert(!splittable<std::string>);
+
+    // Long enough for several SIMD blocks per line.
+    const std::string long_line(100, 'x');
+    const std::string input{long_line + "\n" + long_line + "\n\n"};
+    CHECK((sv_lines(input) | r::to<std::vector>()) ==
+          lines_t{long_line, long_line, ""});
+
+    const line_index index{input};
+    REQUIRE(index.size() == 3);
+    CHECK(index[0] == long_line);
+    CHECK(index[1] == long_line);
+    CHECK(index[2] == "");
+    CHECK(index.offset(1) == 101);
+}
+
+TEST_CASE("extract numbers", "[numbers]")
+{
+    using ints_t = std::vector<int>;
+    CHECK((numbers<int>(std::string_view{"Sensor at x=-2, y=15"}) |
+           r::to<std::vector>()) == ints_t{-2, 15});
+    CHECK((numbers<int>(std::string_view{"2-4,6-8"}) |
+           r::to<std::vector>()) == ints_t{2, 4, 6, 8});
+    CHECK((numbers<int>(std::string_view{"498,4 -> 498,6 - -"}) |
+           r::to<std::vector>()) == ints_t{498, 4, 498, 6});
+    CHECK((numbers<unsigned>(std::string_view{"a-1b2"}) |
+           r::to<std::vector>()) == std::vector<unsigned>{1, 2});
+    CHECK(r::empty(numbers<int>(std::string_view{"no numbers - here"})));
+    static_assert(number_source<std::string_view>);
+    static_assert(number_source<const std::string&>);
+    static_assert(!number_source<std::string>);
+
+    CHECK((numbers<std::int8_t>(std::string_view{"-128 127"}) |
+           r::to<std::vector>()) == std::vector<std::int8_t>{-128, 127});
+    CHECK_THROWS_AS(r::distance(numbers<std::int8_t>(std::string_view{"128"})),
+                    input_error);
+    CHECK_THROWS_AS(r::distance(numbers<std::int8_t>(std::string_view{"-129"})),
+                    input_error);
+}
+
+TEST_CASE("parse numbers into columns", "[parse_columns]")
+{
+    const auto columns{parse_columns<int, 3>(
+        std::string_view{"1,2,3\n-4 -> 5 -> 6\nx=7, y=8, z=9\n"})};
+    REQUIRE(columns.rows() == 3);
+    CHECK(r::equal(columns.column(0), std::vector{1, -4, 7}));
+    CHECK(r::equal(columns.column(2), std::vector{3, 6, 9}));
+    CHECK(columns.row(1) == std::array{-4, 5, 6});
+
+    CHECK(parse_columns<int, 3>(std::string_view{""}).rows() == 0);
+    CHECK_THROWS_AS((parse_columns<int, 3>(std::string_view{"1,2,3\n4,5"})),
+                    input_error);
+    CHECK_THROWS_AS((parse_columns<int, 3>(std::string_view{"1,2,3,4"})),
+                    input_error);
+}
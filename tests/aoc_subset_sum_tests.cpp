@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_subset_sum.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+using namespace aoc;
+using subset_sum::mask_t;
+
+namespace {
+
+std::int64_t masked_sum(const std::vector<int>& items, mask_t mask)
+{
+    std::int64_t sum{0};
+    for (std::size_t i{0}; i < items.size(); i++) {
+        if ((mask >> i & 1) != 0) {
+            sum += items[i];
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST_CASE("subset_sum::for_each_subset visits every subset once",
+          "[subset_sum]")
+{
+    const std::vector<int> items{3, -1, 4, 1, 5};
+    std::set<mask_t> seen;
+    mask_t previous{0};
+    subset_sum::for_each_subset(items, [&](mask_t mask, std::int64_t sum) {
+        CHECK(sum == masked_sum(items, mask));
+        // Gray code order: one item changes at each step.
+        CHECK(std::popcount(mask ^ previous) <= 1);
+        previous = mask;
+        seen.insert(mask);
+    });
+    CHECK(seen.size() == 32);
+}
+
+TEST_CASE("subset_sum counts agree with enumeration", "[subset_sum]")
+{
+    // The 2015 day 17 example, then something with repeats and zeroes.
+    for (const auto& [items, target] :
+         {std::pair{std::vector{20, 15, 10, 5, 5}, 25},
+          std::pair{std::vector{1, 2, 2, 0, 3, 4, 1, 5, 0, 2, 7}, 9}}) {
+        std::vector<std::uint64_t> expected(items.size() + 1);
+        subset_sum::for_each_subset(items, [&](mask_t mask, std::int64_t sum) {
+            if (sum == target) {
+                expected[static_cast<std::size_t>(std::popcount(mask))]++;
+            }
+        });
+        CHECK(subset_sum::count_by_size(items, target) == expected);
+
+        std::set<mask_t> matches;
+        subset_sum::for_each_with_sum(items, target, [&](mask_t mask) {
+            CHECK(masked_sum(items, mask) == target);
+            matches.insert(mask);
+        });
+        std::uint64_t total{0};
+        for (const auto count : expected) {
+            total += count;
+        }
+        CHECK(matches.size() == total);
+    }
+    CHECK(subset_sum::count_by_size(std::vector{20, 15, 10, 5, 5}, 25) ==
+          std::vector<std::uint64_t>{0, 0, 3, 1, 0, 0});
+    CHECK_THROWS_AS(subset_sum::count_by_size(std::vector{1, -1}, 0),
+                    input_error);
+}
+
+TEST_CASE("subset_sum::for_each_with_sum handles many items", "[subset_sum]")
+{
+    std::vector<int> items;
+    for (int i{0}; i < 40; i++) {
+        items.push_back(1 << (i % 10));
+    }
+    std::uint64_t count{0};
+    subset_sum::for_each_with_sum(items, 1023, [&](mask_t) { count++; });
+    std::uint64_t expected{0};
+    for (const auto c : subset_sum::count_by_size(items, 1023)) {
+        expected += c;
+    }
+    CHECK(count == expected);
+}
+
+TEST_CASE("subset_sum::smallest_group splits the 2015 day 24 example",
+          "[subset_sum]")
+{
+    const std::vector<int> packages{1, 2, 3, 4, 5, 7, 8, 9, 10, 11};
+    const auto three{subset_sum::smallest_group(packages, 3)};
+    REQUIRE(three);
+    CHECK(three->size == 2);
+    CHECK(three->product == 99);
+    CHECK(masked_sum(packages, three->members) == 20);
+
+    const auto four{subset_sum::smallest_group(packages, 4)};
+    REQUIRE(four);
+    CHECK(four->product == 44);
+
+    // The sum splits evenly, but the items don't.
+    CHECK(!subset_sum::smallest_group(std::vector{1, 1, 4}, 2));
+    CHECK(!subset_sum::smallest_group(std::vector{1, 2}, 2));
+    CHECK_THROWS_AS(subset_sum::smallest_group(std::vector{1, 0, 1}, 2),
+                    input_error);
+}
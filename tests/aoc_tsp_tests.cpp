@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <aoc_tsp.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+tsp::distance_matrix<int> random_matrix(std::size_t n, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> cost{-50, 100};
+    tsp::distance_matrix<int> d{n};
+    for (std::size_t i{0}; i < n; i++) {
+        for (std::size_t j{0}; j < n; j++) {
+            d(i, j) = i == j ? 0 : cost(rng);
+        }
+    }
+    return d;
+}
+
+// Best route by trying every order of the nodes.
+int brute_force(const tsp::distance_matrix<int>& d, tsp::route kind,
+                tsp::objective goal)
+{
+    std::vector<std::size_t> order(d.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    bool first{true};
+    int best{0};
+    do {
+        int cost{0};
+        for (std::size_t k{0}; k + 1 < order.size(); k++) {
+            cost += d(order[k], order[k + 1]);
+        }
+        if (kind == tsp::route::cycle) {
+            cost += d(order.back(), order.front());
+        }
+        if (first || (goal == tsp::objective::minimize ? cost < best
+                                                       : cost > best)) {
+            best = cost;
+            first = false;
+        }
+    } while (std::next_permutation(order.begin(), order.end()));
+    return best;
+}
+
+}  // namespace
+
+TEST_CASE("tsp::solve matches a brute force search", "[tsp]")
+{
+    std::mt19937 rng{2015};
+    for (std::size_t n{1}; n <= 7; n++) {
+        const auto d{random_matrix(n, rng)};
+        for (const auto kind : {tsp::route::path, tsp::route::cycle}) {
+            for (const auto goal :
+                 {tsp::objective::minimize, tsp::objective::maximize}) {
+                CHECK(tsp::solve(d, kind, goal) == brute_force(d, kind, goal));
+            }
+        }
+    }
+}
+
+TEST_CASE("tsp::solve gives the same answer on several threads", "[tsp]")
+{
+    std::mt19937 rng{9};
+    const auto d{random_matrix(15, rng)};
+    for (const auto kind : {tsp::route::path, tsp::route::cycle}) {
+        for (const auto goal :
+             {tsp::objective::minimize, tsp::objective::maximize}) {
+            CHECK(tsp::solve(d, kind, goal, 4) == tsp::solve(d, kind, goal));
+        }
+    }
+}
+
+TEST_CASE("tsp::solve handles the 2015 day 9 example", "[tsp]")
+{
+    // London, Dublin, Belfast
+    tsp::distance_matrix<int> d{3};
+    d(0, 1) = d(1, 0) = 464;
+    d(0, 2) = d(2, 0) = 518;
+    d(1, 2) = d(2, 1) = 141;
+    CHECK(tsp::solve(d, tsp::route::path, tsp::objective::minimize) == 605);
+    CHECK(tsp::solve(d, tsp::route::path, tsp::objective::maximize) == 982);
+    CHECK(tsp::solve(d, tsp::route::cycle, tsp::objective::minimize) ==
+          464 + 518 + 141);
+
+    CHECK(tsp::solve(tsp::distance_matrix<int>{0}, tsp::route::cycle,
+                     tsp::objective::minimize) == 0);
+    CHECK_THROWS_AS(tsp::solve(tsp::distance_matrix<int>{tsp::max_nodes + 1},
+                               tsp::route::path, tsp::objective::minimize),
+                    input_error);
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2023 David Holmes (dholmes at dholmes dot us)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <small_vector.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace aoc;
+
+TEST_CASE("small_vector stays inline until full", "[small_vector]")
+{
+    small_vector<int, 4> v;
+    CHECK(v.empty());
+    CHECK(v.capacity() == 4);
+    for (int i{0}; i < 4; i++) {
+        v.push_back(i);
+    }
+    CHECK(v.is_inline());
+    CHECK(v.size() == 4);
+
+    v.push_back(4);
+    CHECK_FALSE(v.is_inline());
+    CHECK(v.capacity() >= 5);
+    CHECK(std::ranges::equal(v, std::array{0, 1, 2, 3, 4}));
+
+    v.resize(2);
+    v.shrink_to_fit();
+    CHECK(v.is_inline());
+    CHECK(std::ranges::equal(v, std::array{0, 1}));
+}
+
+TEST_CASE("small_vector constructors", "[small_vector]")
+{
+    const small_vector<int, 2> filled(3, 7);
+    CHECK(std::ranges::equal(filled, std::array{7, 7, 7}));
+
+    const small_vector<int, 2> sized(3);
+    CHECK(std::ranges::equal(sized, std::array{0, 0, 0}));
+
+    const std::array<int, 3> values{1, 2, 3};
+    const small_vector<int, 4> from_range{values.begin(), values.end()};
+    CHECK(std::ranges::equal(from_range, values));
+
+    const small_vector<int, 4> from_list{1, 2, 3};
+    CHECK(from_list == from_range);
+}
+
+TEST_CASE("small_vector copy and move", "[small_vector]")
+{
+    // Check both inline and spilled contents, with a type that owns memory.
+    for (const std::size_t count : {std::size_t{2}, std::size_t{6}}) {
+        small_vector<std::string, 3> v1;
+        for (std::size_t i{0}; i < count; i++) {
+            v1.push_back(std::string(20, static_cast<char>('a' + i)));
+        }
+        const small_vector<std::string, 3> copy{v1};
+        CHECK(copy == v1);
+
+        small_vector<std::string, 3> moved{std::move(v1)};
+        CHECK(v1.empty());
+        CHECK(moved == copy);
+
+        small_vector<std::string, 3> assigned;
+        assigned = moved;
+        CHECK(assigned == copy);
+        assigned = std::move(moved);
+        CHECK(moved.empty());
+        CHECK(assigned == copy);
+    }
+}
+
+TEST_CASE("small_vector of move-only type", "[small_vector]")
+{
+    small_vector<std::unique_ptr<int>, 2> v;
+    for (int i{0}; i < 5; i++) {
+        v.push_back(std::make_unique<int>(i));
+    }
+    auto moved{std::move(v)};
+    CHECK(moved.size() == 5);
+    CHECK(*moved[4] == 4);
+}
+
+TEST_CASE("small_vector insert and erase", "[small_vector]")
+{
+    small_vector<int, 4> v{1, 2, 3};
+    auto iter{v.insert(v.begin() + 1, 10)};
+    CHECK(*iter == 10);
+    CHECK(std::ranges::equal(v, std::array{1, 10, 2, 3}));
+
+    v.insert(v.end(), 2, 20);
+    CHECK(std::ranges::equal(v, std::array{1, 10, 2, 3, 20, 20}));
+
+    const std::array<int, 2> more{30, 31};
+    v.insert(v.begin(), more.begin(), more.end());
+    CHECK(std::ranges::equal(v, std::array{30, 31, 1, 10, 2, 3, 20, 20}));
+
+    // Inserting a copy of an element while growing.
+    v.shrink_to_fit();
+    v.insert(v.begin(), v.back());
+    CHECK(v.front() == 20);
+    CHECK(v.size() == 9);
+
+    iter = v.erase(v.begin(), v.begin() + 3);
+    CHECK(*iter == 1);
+    CHECK(std::ranges::equal(v, std::array{1, 10, 2, 3, 20, 20}));
+    v.erase(v.begin() + 1);
+    CHECK(std::ranges::equal(v, std::array{1, 2, 3, 20, 20}));
+
+    CHECK(erase(v, 20) == 2);
+    CHECK(erase_if(v, [](int x) { return x % 2 == 1; }) == 2);
+    CHECK(std::ranges::equal(v, std::array{2}));
+}
+
+TEST_CASE("small_vector swap and compare", "[small_vector]")
+{
+    small_vector<int, 2> a{1, 2, 3};
+    small_vector<int, 2> b{4};
+    swap(a, b);
+    CHECK(std::ranges::equal(a, std::array{4}));
+    CHECK(std::ranges::equal(b, std::array{1, 2, 3}));
+    CHECK(b < a);
+    CHECK(a != b);
+
+    CHECK_THROWS_AS(a.at(1), std::out_of_range);
+}
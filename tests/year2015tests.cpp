@@ -9,6 +9,8 @@
 #include <aoc_range.hpp>
 #include <day06.hpp>
 #include <gate.hpp>
+#include <look_and_say.hpp>
+#include <year2015.hpp>
 
 extern "C" {
 #include <md5.h>
@@ -104,3 +106,157 @@ NOT y -> i)"};
     CHECK(circuit.get_signal("x") == signal{123});
     CHECK(circuit.get_signal("y") == signal{456});
 }
+
+TEST_CASE("2015 day 07 circuit re-evaluation", "[2015-07]")
+{
+    // The gates are listed out of order, and "in" is driven by nothing.
+    auto in{
+        R"(
+b AND c -> d
+in -> a
+a OR 1 -> b
+a LSHIFT 1 -> c
+NOT d -> e)"};
+    auto circuit{build_circuit(in)};
+    CHECK_THROWS_AS(circuit.evaluate(), aoc::input_error);
+
+    circuit.set_signal("in", 6);
+    circuit.evaluate();
+    CHECK(circuit.get_signal("d") == signal{4});
+    CHECK(circuit.get_signal("e") == signal{65531});
+
+    circuit.set_signal("in", 3);
+    circuit.evaluate();
+    CHECK(circuit.get_signal("d") == signal{2});
+    CHECK(circuit.get_signal("e") == signal{65533});
+
+    // Overriding a wire driven by a gate.
+    circuit.set_signal("c", 0xffff);
+    circuit.evaluate();
+    CHECK(circuit.get_signal("b") == signal{3});
+    CHECK(circuit.get_signal("d") == signal{3});
+
+    circuit.reset();
+    circuit.set_signal("in", 6);
+    circuit.evaluate();
+    CHECK(circuit.get_signal("d") == signal{4});
+
+    CHECK_THROWS_AS(build_circuit("a -> b\nb -> a"), aoc::input_error);
+}
+
+TEST_CASE("2015 day 07 circuit batch evaluation", "[2015-07]")
+{
+    auto in{
+        R"(
+x AND y -> d
+x OR 7 -> e
+x LSHIFT s -> f
+y RSHIFT s -> g
+NOT d -> h
+f OR g -> i
+5 -> s)"};
+    auto circuit{build_circuit(in)};
+    circuit.set_signal("y", 0xbeef);
+
+    // Enough assignments for more than one batch, overriding different
+    // wires, including the shift amount and a wire driven by a gate.
+    std::vector<wire_signals> overrides;
+    for (int n{0}; n < 100; n++) {
+        wire_signals o{{"x", static_cast<signal>(n * 977)}};
+        if (n % 3 == 0) {
+            o.emplace_back("s", static_cast<signal>(n % 20));
+        }
+        if (n % 7 == 0) {
+            o.emplace_back("d", static_cast<signal>(n));
+        }
+        overrides.push_back(std::move(o));
+    }
+    const std::vector<wire> outputs{"d", "e", "f", "g", "h", "i"};
+    const auto batch{circuit.evaluate_batch(overrides, outputs)};
+    REQUIRE(batch.size() == overrides.size());
+
+    for (std::size_t n{0}; n < overrides.size(); n++) {
+        circuit.reset();
+        circuit.set_signal("y", 0xbeef);
+        for (const auto& [w, s] : overrides[n]) {
+            circuit.set_signal(w, s);
+        }
+        circuit.evaluate();
+        for (std::size_t k{0}; k < outputs.size(); k++) {
+            CHECK(batch[n][k] == circuit.get_signal(outputs[k]));
+        }
+    }
+
+    circuit.reset();
+    const std::vector<wire_signals> no_x(3);
+    CHECK_THROWS_AS(circuit.evaluate_batch(no_x, outputs), aoc::input_error);
+}
+
+TEST_CASE("2015 day 10 look-and-say", "[2015-10]")
+{
+    using namespace aoc::year2015::look_and_say;
+    CHECK(say("1") == "11");
+    CHECK(say("1211") == "111221");
+    CHECK(say("111221") == "312211");
+    CHECK(say("1111111111") == "101");
+
+    // Starts which are a single element, a compound, not yet split into
+    // elements, and which never split (with a digit above 3).
+    for (const std::string_view start : {"3113322113", "1", "1113222113",
+                                         "333", "14"}) {
+        const sequence seq{start};
+        std::string term{start};
+        for (std::size_t step{0}; step <= 30; step++) {
+            CHECK(seq.length_after(step) == term.size());
+            if (step % 10 == 0) {
+                auto digits{seq.digits_after(step)};
+                std::string streamed;
+                while (const auto c{digits.next()}) {
+                    streamed.push_back(*c);
+                }
+                CHECK(streamed == term);
+            }
+            term = say(term);
+        }
+    }
+    CHECK(sequence{"3113322113"}.length_after(50) == 4666278);
+    CHECK_THROWS_AS(sequence{"12a"}, aoc::input_error);
+}
+
+TEST_CASE("2015 day 11 next password", "[2015-11]")
+{
+    using aoc::year2015::day11;
+    CHECK(day11("abcdefgh") == aoc::solution_result{"abcdffaa", "abcdffbb"});
+    // Skips past the disallowed i without trying what follows it.
+    CHECK(day11("ghijklmn\n") ==
+          aoc::solution_result{"ghjaabcc", "ghjbbcdd"});
+    // The last letters can't be raised enough, so an earlier one is.
+    CHECK(day11("xxyzzzzz").part_a == "xxzaaabc");
+    CHECK_THROWS_AS(day11("zzzzzzzz"), aoc::solution_error);
+    CHECK_THROWS_AS(day11("abcdefg"), aoc::input_error);
+    CHECK_THROWS_AS(day11("abcdefgH"), aoc::input_error);
+}
+
+TEST_CASE("2015 day 12 number sums", "[2015-12]")
+{
+    using aoc::year2015::day12;
+    CHECK(day12(R"([1,2,3])") == aoc::solution_result{6, 6});
+    CHECK(day12(R"([1,{"c":"red","b":2},3])") ==
+          aoc::solution_result{6, 4});
+    CHECK(day12(R"({"d":"red","e":[1,2,3,4],"f":5})") ==
+          aoc::solution_result{15, 0});
+    CHECK(day12(R"([1,"red",5])") == aoc::solution_result{6, 6});
+    CHECK(day12(R"({"a":{"b":4},"c":-1})") == aoc::solution_result{3, 3});
+}
+
+TEST_CASE("2015 day 22 wizard battle", "[2015-22]")
+{
+    using aoc::year2015::day22;
+    CHECK(day22("Hit Points: 13\nDamage: 8\n") ==
+          aoc::solution_result{212, 212});
+    CHECK(day22("Hit Points: 58\nDamage: 9\n") ==
+          aoc::solution_result{1269, 1309});
+    CHECK_THROWS_AS(day22("Hit Points: 250\nDamage: 60\n"),
+                    aoc::solution_error);
+    CHECK_THROWS_AS(day22("Hit Points: 300\nDamage: 8\n"), aoc::input_error);
+}